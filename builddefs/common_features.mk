@@ -283,6 +283,18 @@ ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
   endif
 endif
 
+VALID_AUTOCORRECT_DATA_DRIVER_TYPES := progmem flash
+AUTOCORRECT_DATA_DRIVER ?= progmem
+ifeq ($(strip $(AUTOCORRECT_ENABLE)), yes)
+    ifeq ($(filter $(AUTOCORRECT_DATA_DRIVER),$(VALID_AUTOCORRECT_DATA_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid AUTOCORRECT_DATA_DRIVER,AUTOCORRECT_DATA_DRIVER="$(AUTOCORRECT_DATA_DRIVER)" is not a valid autocorrect data driver)
+    else ifeq ($(strip $(AUTOCORRECT_DATA_DRIVER)), flash)
+        OPT_DEFS += -DAUTOCORRECT_DATA_FLASH
+        FLASH_DRIVER ?= spi
+        SRC += $(QUANTUM_DIR)/process_keycode/autocorrect_flash.c
+    endif
+endif
+
 VALID_FLASH_DRIVER_TYPES := spi custom
 FLASH_DRIVER ?= none
 ifneq ($(strip $(FLASH_DRIVER)), none)
@@ -947,6 +959,16 @@ ifeq ($(strip $(DIP_SWITCH_ENABLE)), yes)
     endif
 endif
 
+ifneq ($(filter yes,$(strip $(AUTO_SHIFT_ENABLE) $(CAPS_WORD_ENABLE) $(DYNAMIC_MACRO_ENABLE) $(KEY_OVERRIDE_ENABLE) $(LAYER_LOCK_ENABLE) $(SECURE_ENABLE) $(TAP_DANCE_ENABLE))),)
+    DEADLINE_ENABLE := yes
+endif
+
+ifeq ($(strip $(LEADER_ENABLE)), yes)
+    ifeq ($(strip $(LEADER_SEQUENCES_ENABLE)), yes)
+        OPT_DEFS += -DLEADER_SEQUENCES_ENABLE
+    endif
+endif
+
 ifeq ($(strip $(BATTERY_ENABLE)), yes)
     BATTERY_DRIVER_REQUIRED := yes
 endif
@@ -28,6 +28,7 @@ GENERIC_FEATURES = \
     COMMAND \
     CONNECTION \
     CRC \
+    DEADLINE \
     DEFERRED_EXEC \
     DIGITIZER \
     DIP_SWITCH \
@@ -0,0 +1,21 @@
+WS2812_ENCODE_TEST_INC := $(DRIVER_PATH)/led
+
+WS2812_ENCODE_TEST_SRC := \
+	$(DRIVER_PATH)/led/tests/ws2812_encode_tests.cpp \
+	$(DRIVER_PATH)/led/ws2812.c
+
+ws2812_encode_grb_DEFS := -DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_GRB
+ws2812_encode_grb_INC := $(WS2812_ENCODE_TEST_INC)
+ws2812_encode_grb_SRC := $(WS2812_ENCODE_TEST_SRC)
+
+ws2812_encode_rgb_DEFS := -DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_RGB
+ws2812_encode_rgb_INC := $(WS2812_ENCODE_TEST_INC)
+ws2812_encode_rgb_SRC := $(WS2812_ENCODE_TEST_SRC)
+
+ws2812_encode_bgr_DEFS := -DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_BGR
+ws2812_encode_bgr_INC := $(WS2812_ENCODE_TEST_INC)
+ws2812_encode_bgr_SRC := $(WS2812_ENCODE_TEST_SRC)
+
+ws2812_encode_rgbw_DEFS := -DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_GRB -DWS2812_RGBW
+ws2812_encode_rgbw_INC := $(WS2812_ENCODE_TEST_INC)
+ws2812_encode_rgbw_SRC := $(WS2812_ENCODE_TEST_SRC)
@@ -0,0 +1,167 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812.h"
+}
+
+#ifdef WS2812_RGBW
+#    define WS2812_CHANNELS 4
+#else
+#    define WS2812_CHANNELS 3
+#endif
+
+// The nibble tables of the SPI and PWM drivers, built the same way as in the drivers
+static const uint16_t spi_nibbles[16] = WS2812_NIBBLE_TABLE(WS2812_SPI_NIBBLE);
+
+// Duty cycles that use every byte of the buffer entries, so that a partial copy shows up
+#define PWM_NIBBLE_8(n) WS2812_PWM_NIBBLE(n, 0x21, 0x43)
+#define PWM_NIBBLE_16(n) WS2812_PWM_NIBBLE(n, 0x2165, 0x4387)
+#define PWM_NIBBLE_32(n) WS2812_PWM_NIBBLE(n, 0x21658709, 0x4387A9CB)
+
+static const uint8_t  pwm_nibbles_8[16][4]  = WS2812_NIBBLE_TABLE(PWM_NIBBLE_8);
+static const uint16_t pwm_nibbles_16[16][4] = WS2812_NIBBLE_TABLE(PWM_NIBBLE_16);
+static const uint32_t pwm_nibbles_32[16][4] = WS2812_NIBBLE_TABLE(PWM_NIBBLE_32);
+
+/*
+ * The per-bit encoding of the SPI driver before ws2812_encode()
+ */
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+static void spi_set_led_color_rgb(uint8_t *tx_start, ws2812_led_t color, int pos) {
+    const int BYTES_FOR_LED_BYTE = 4;
+    const int BYTES_FOR_LED      = BYTES_FOR_LED_BYTE * WS2812_CHANNELS;
+
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+#endif
+#ifdef WS2812_RGBW
+    for (int j = 0; j < 4; j++)
+        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+#endif
+}
+
+/*
+ * The per-bit encoding of the PWM driver before ws2812_encode()
+ */
+#define WS2812_BIT(led, byte, bit) (WS2812_CHANNELS * 8 * (led) + 8 * (byte) + (7 - (bit)))
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 1, (bit))
+#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 0, (bit))
+#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 0, (bit))
+#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
+#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 2, (bit))
+#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
+#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 0, (bit))
+#endif
+#define WS2812_WHITE_BIT(led, bit) WS2812_BIT((led), 3, (bit))
+
+template <typename T>
+static void pwm_write_led(T *frame_buffer, T duty_0, T duty_1, uint16_t led_number, const ws2812_led_t &led) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((led.r >> bit) & 0x01) ? duty_1 : duty_0;
+        frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((led.g >> bit) & 0x01) ? duty_1 : duty_0;
+        frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((led.b >> bit) & 0x01) ? duty_1 : duty_0;
+#ifdef WS2812_RGBW
+        frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((led.w >> bit) & 0x01) ? duty_1 : duty_0;
+#endif
+    }
+}
+
+class WS2812Encode : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Every channel goes through all 256 values, in a different order
+        for (int i = 0; i < 256; i++) {
+            ws2812_led_t led;
+            led.r = i;
+            led.g = 255 - i;
+            led.b = i * 37;
+#ifdef WS2812_RGBW
+            led.w = i * 101;
+#endif
+            leds.push_back(led);
+        }
+    }
+
+    template <typename T>
+    void ExpectPwmEncoding(const T (*nibbles)[4], T duty_0, T duty_1) {
+        const ws2812_encoding_t encoding = {.nibbles = nibbles, .nibble_size = sizeof(nibbles[0])};
+
+        // One spare entry on each side, to catch writes out of the frame
+        std::vector<T> expected(leds.size() * WS2812_CHANNELS * 8 + 2, 0x55);
+        std::vector<T> actual(expected.size(), 0x55);
+        for (size_t i = 0; i < leds.size(); i++) {
+            pwm_write_led(&expected[1], duty_0, duty_1, i, leds[i]);
+        }
+        ws2812_encode(&actual[1], &encoding, leds.data(), leds.size());
+
+        EXPECT_EQ(actual, expected);
+    }
+
+    std::vector<ws2812_led_t> leds;
+};
+
+TEST_F(WS2812Encode, SpiMatchesPerBitEncoding) {
+    const ws2812_encoding_t encoding = {.nibbles = spi_nibbles, .nibble_size = sizeof(spi_nibbles[0])};
+
+    // One spare byte on each side, to catch writes out of the frame
+    std::vector<uint8_t> expected(leds.size() * WS2812_CHANNELS * 4 + 2, 0x55);
+    std::vector<uint8_t> actual(expected.size(), 0x55);
+    for (size_t i = 0; i < leds.size(); i++) {
+        spi_set_led_color_rgb(&expected[1], leds[i], i);
+    }
+    ws2812_encode(&actual[1], &encoding, leds.data(), leds.size());
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(WS2812Encode, Pwm8BitMatchesPerBitEncoding) {
+    ExpectPwmEncoding<uint8_t>(pwm_nibbles_8, 0x21, 0x43);
+}
+
+TEST_F(WS2812Encode, Pwm16BitMatchesPerBitEncoding) {
+    ExpectPwmEncoding<uint16_t>(pwm_nibbles_16, 0x2165, 0x4387);
+}
+
+TEST_F(WS2812Encode, Pwm32BitMatchesPerBitEncoding) {
+    ExpectPwmEncoding<uint32_t>(pwm_nibbles_32, 0x21658709, 0x4387A9CB);
+}
@@ -1,6 +1,8 @@
 // Copyright 2024 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <stdbool.h>
+#include <string.h>
 #include "ws2812.h"
 
 #if defined(WS2812_RGBW)
@@ -13,3 +15,65 @@ void ws2812_rgb_to_rgbw(ws2812_led_t *led) {
     led->b -= led->w;
 }
 #endif
+
+#ifdef WS2812_OUTPUT_CURVE
+static uint8_t ws2812_curve[256];
+static bool    ws2812_curve_ready = false;
+
+static void ws2812_build_curve(void) {
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t value = i;
+#    ifdef WS2812_GAMMA_CORRECTION
+        // gamma of 2, exact at both ends
+        value = (value * value + value) >> 8;
+#    endif
+#    ifdef WS2812_BRIGHTNESS
+        value = (value * (WS2812_BRIGHTNESS + 1)) >> 8;
+#    endif
+        ws2812_curve[i] = value;
+    }
+    ws2812_curve_ready = true;
+}
+#endif
+
+// `size` is a constant at each call site, so the copies compile to plain loads and stores of the right width
+__attribute__((always_inline)) static inline void ws2812_encode_bytes(uint8_t *out, const uint8_t *nibbles, uint8_t size, const uint8_t *data, const uint8_t *end) {
+    while (data < end) {
+#ifdef WS2812_OUTPUT_CURVE
+        uint8_t value = ws2812_curve[*data++];
+#else
+        uint8_t value = *data++;
+#endif
+        memcpy(out, &nibbles[(value >> 4) * size], size);
+        memcpy(out + size, &nibbles[(value & 0x0F) * size], size);
+        out += 2 * size;
+    }
+}
+
+void ws2812_encode(void *buffer, const ws2812_encoding_t *encoding, const ws2812_led_t *leds, uint16_t count) {
+    // ws2812_led_t is packed in wire order, so the frame can be walked as a flat run of bytes
+    const uint8_t *data    = (const uint8_t *)leds;
+    const uint8_t *end     = data + count * sizeof(ws2812_led_t);
+    const uint8_t *nibbles = encoding->nibbles;
+
+#ifdef WS2812_OUTPUT_CURVE
+    if (!ws2812_curve_ready) {
+        ws2812_build_curve();
+    }
+#endif
+
+    switch (encoding->nibble_size) {
+        case 2:
+            ws2812_encode_bytes(buffer, nibbles, 2, data, end);
+            break;
+        case 4:
+            ws2812_encode_bytes(buffer, nibbles, 4, data, end);
+            break;
+        case 8:
+            ws2812_encode_bytes(buffer, nibbles, 8, data, end);
+            break;
+        case 16:
+            ws2812_encode_bytes(buffer, nibbles, 16, data, end);
+            break;
+    }
+}
@@ -95,3 +95,46 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_flush(void);
 
 void ws2812_rgb_to_rgbw(ws2812_led_t *led);
+
+/*
+ * Brightness and gamma are applied while encoding the frame by the drivers that build a bitstream
+ * in RAM (SPI and PWM), at no extra cost per LED beyond a table lookup.
+ */
+#if defined(WS2812_BRIGHTNESS) || defined(WS2812_GAMMA_CORRECTION)
+#    define WS2812_OUTPUT_CURVE
+#endif
+
+/**
+ * Describes how a driver encodes the bits of the color data.
+ *
+ * Each of the 16 possible nibbles maps to `nibble_size` bytes of output, most significant bit
+ * first, so a whole color byte is encoded with two table lookups. `nibble_size` must be 2, 4, 8
+ * or 16. Entries are copied to the destination buffer exactly as they are laid out in memory.
+ */
+typedef struct {
+    const void *nibbles;
+    uint8_t     nibble_size;
+} ws2812_encoding_t;
+
+/**
+ * Initializer of a nibble table, where `entry(n)` gives the output for nibble `n`.
+ */
+#define WS2812_NIBBLE_TABLE(entry) \
+    { entry(0), entry(1), entry(2), entry(3), entry(4), entry(5), entry(6), entry(7), entry(8), entry(9), entry(10), entry(11), entry(12), entry(13), entry(14), entry(15) }
+
+/*
+ * The SPI driver sends each bit of LED data as four SPI bits, so a nibble is two bytes. The first
+ * two bits go in the low byte, as ChibiOS targets are little-endian.
+ */
+#define WS2812_SPI_BITS(bit) ((bit) ? 0b1110 : 0b1000)
+#define WS2812_SPI_NIBBLE(n) ((WS2812_SPI_BITS((n) & 8) << 4 | WS2812_SPI_BITS((n) & 4)) | (WS2812_SPI_BITS((n) & 2) << 4 | WS2812_SPI_BITS((n) & 1)) << 8)
+
+/*
+ * The PWM driver sends each bit of LED data as one duty cycle.
+ */
+#define WS2812_PWM_NIBBLE(n, duty_0, duty_1) {((n) & 8) ? (duty_1) : (duty_0), ((n) & 4) ? (duty_1) : (duty_0), ((n) & 2) ? (duty_1) : (duty_0), ((n) & 1) ? (duty_1) : (duty_0)}
+
+/**
+ * Encode `count` LEDs into `buffer`, in a single pass over the whole frame.
+ */
+void ws2812_encode(void *buffer, const ws2812_encoding_t *encoding, const ws2812_led_t *leds, uint16_t count);
@@ -116,6 +116,31 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define OLED_ALL_BLOCKS_MASK (((((OLED_BLOCK_TYPE)1 << (OLED_BLOCK_COUNT - 1)) - 1) << 1) | 1)
 
+#ifdef OLED_DIRTY_TILE_WIDTH
+#    if (OLED_DISPLAY_WIDTH % OLED_DIRTY_TILE_WIDTH) != 0
+#        error OLED_DIRTY_TILE_WIDTH must evenly divide OLED_DISPLAY_WIDTH
+#    endif
+#    define OLED_PAGE_COUNT (OLED_MATRIX_SIZE / OLED_DISPLAY_WIDTH)
+#    define OLED_DIRTY_TILE_COUNT (OLED_DISPLAY_WIDTH / OLED_DIRTY_TILE_WIDTH)
+#    if OLED_DIRTY_TILE_COUNT > 32
+#        error OLED_DIRTY_TILE_WIDTH is too small, a page may hold at most 32 tiles
+#    elif OLED_DIRTY_TILE_COUNT > 16
+#        define OLED_DIRTY_TILE_TYPE uint32_t
+#    elif OLED_DIRTY_TILE_COUNT > 8
+#        define OLED_DIRTY_TILE_TYPE uint16_t
+#    else
+#        define OLED_DIRTY_TILE_TYPE uint8_t
+#    endif
+#    define OLED_ALL_TILES_MASK ((OLED_DIRTY_TILE_TYPE)(((((OLED_DIRTY_TILE_TYPE)1 << (OLED_DIRTY_TILE_COUNT - 1)) - 1) << 1) | 1))
+#endif
+
+#if OLED_UPDATE_TIME_BUDGET > 0
+// Always render at least one chunk, then keep going until the budget is spent
+#    define OLED_RENDER_CONTINUE(num_processed, render_start) ((num_processed) == 0 || timer_elapsed(render_start) < OLED_UPDATE_TIME_BUDGET)
+#else
+#    define OLED_RENDER_CONTINUE(num_processed, render_start) ((num_processed) < OLED_UPDATE_PROCESS_LIMIT)
+#endif
+
 #define OLED_IC_HAS_HORIZONTAL_MODE (OLED_IC == OLED_IC_SSD1306)
 #define OLED_IC_COM_PINS_ARE_COLUMNS (OLED_IC == OLED_IC_SH1107)
 
@@ -158,6 +183,12 @@ uint8_t         oled_rotation_width = 0;
 uint8_t         oled_scroll_speed   = 0; // this holds the speed after being remapped to ssd1306 internal values
 uint8_t         oled_scroll_start   = 0;
 uint8_t         oled_scroll_end     = 7;
+#ifdef OLED_DIRTY_TILE_WIDTH
+// One bit per OLED_DIRTY_TILE_WIDTH columns of each page
+static OLED_DIRTY_TILE_TYPE oled_dirty_tiles[OLED_PAGE_COUNT];
+// Blocks of oled_dirty whose changes are already in the tile map, any others were set on oled_dirty directly
+static OLED_BLOCK_TYPE oled_dirty_tiled = 0;
+#endif
 #if OLED_TIMEOUT > 0
 uint32_t oled_timeout;
 #endif
@@ -276,6 +307,33 @@ __attribute__((weak)) void oled_driver_init(void) {
 #endif
 }
 
+static OLED_BLOCK_TYPE oled_dirty_blocks(uint16_t index, uint16_t length) {
+    OLED_BLOCK_TYPE blocks = 0;
+    for (uint16_t block = index / OLED_BLOCK_SIZE; block <= (index + length - 1) / OLED_BLOCK_SIZE; ++block) {
+        blocks |= ((OLED_BLOCK_TYPE)1 << block);
+    }
+    return blocks;
+}
+
+#ifdef OLED_DIRTY_TILE_WIDTH
+static void oled_mark_dirty_tiles(uint16_t index, uint16_t length) {
+    // Tiles never straddle pages, so they can be numbered linearly through the buffer
+    for (uint16_t tile = index / OLED_DIRTY_TILE_WIDTH; tile <= (index + length - 1) / OLED_DIRTY_TILE_WIDTH; ++tile) {
+        oled_dirty_tiles[tile / OLED_DIRTY_TILE_COUNT] |= ((OLED_DIRTY_TILE_TYPE)1 << (tile % OLED_DIRTY_TILE_COUNT));
+    }
+}
+#endif
+
+// Marks the buffer range [index, index + length) as needing to be rendered
+static void oled_mark_dirty(uint16_t index, uint16_t length) {
+    OLED_BLOCK_TYPE blocks = oled_dirty_blocks(index, length);
+    oled_dirty |= blocks;
+#ifdef OLED_DIRTY_TILE_WIDTH
+    oled_dirty_tiled |= blocks;
+    oled_mark_dirty_tiles(index, length);
+#endif
+}
+
 // Flips the rendering bits for a character at the current cursor position
 static void InvertCharacter(uint8_t *cursor) {
     const uint8_t *end = cursor + OLED_FONT_WIDTH;
@@ -375,7 +433,7 @@ __attribute__((weak)) oled_rotation_t oled_init_user(oled_rotation_t rotation) {
 void oled_clear(void) {
     memset(oled_buffer, 0, sizeof(oled_buffer));
     oled_cursor = &oled_buffer[0];
-    oled_dirty  = OLED_ALL_BLOCKS_MASK;
+    oled_mark_dirty(0, OLED_MATRIX_SIZE);
 }
 
 static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
@@ -442,6 +500,81 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#ifdef OLED_DIRTY_TILE_WIDTH
+static void oled_render_tiles(bool all) {
+    uint8_t num_processed = 0;
+#    if OLED_UPDATE_TIME_BUDGET > 0
+    uint16_t render_start = timer_read();
+#    endif
+    for (uint8_t page = 0; page < OLED_PAGE_COUNT; ++page) {
+        while (oled_dirty_tiles[page] && (all || OLED_RENDER_CONTINUE(num_processed, render_start))) {
+            // Find the next run of adjacent dirty tiles in this page
+            OLED_DIRTY_TILE_TYPE tiles = oled_dirty_tiles[page];
+            uint8_t              first = 0;
+            while (!(tiles & ((OLED_DIRTY_TILE_TYPE)1 << first))) {
+                ++first;
+            }
+            uint8_t last = first;
+            while (last + 1 < OLED_DIRTY_TILE_COUNT && (tiles & ((OLED_DIRTY_TILE_TYPE)1 << (last + 1)))) {
+                ++last;
+            }
+
+            uint8_t  start_column = first * OLED_DIRTY_TILE_WIDTH;
+            uint16_t width        = (last - first + 1) * OLED_DIRTY_TILE_WIDTH;
+            uint8_t  end_page     = page;
+
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+            // Full pages are contiguous in the buffer, so following pages that are fully dirty can share the window
+            if (width == OLED_DISPLAY_WIDTH) {
+                while (end_page + 1 < OLED_PAGE_COUNT && oled_dirty_tiles[end_page + 1] == OLED_ALL_TILES_MASK) {
+                    ++end_page;
+                }
+            }
+            uint8_t display_window[] = {I2C_CMD, COLUMN_ADDR, OLED_COLUMN_OFFSET + start_column, OLED_COLUMN_OFFSET + start_column + width - 1, PAGE_ADDR, page, end_page};
+#    else
+            uint8_t display_window[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f), PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f)};
+#    endif
+            if (!oled_send_cmd(display_window, ARRAY_SIZE(display_window))) {
+                print("oled_render offset command failed\n");
+                return;
+            }
+            if (!oled_send_data(&oled_buffer[page * OLED_DISPLAY_WIDTH + start_column], width * (end_page - page + 1))) {
+                print("oled_render data failed\n");
+                return;
+            }
+
+            // Clear dirty flags of the just rendered tiles
+            oled_dirty_tiles[page] &= ~(OLED_DIRTY_TILE_TYPE)((OLED_ALL_TILES_MASK >> (OLED_DIRTY_TILE_COUNT - 1 - last)) & (OLED_ALL_TILES_MASK << first));
+            while (page < end_page) {
+                oled_dirty_tiles[++page] = 0;
+            }
+            ++num_processed;
+        }
+    }
+}
+
+// Adds the blocks set on oled_dirty directly to the tile map, before it replaces oled_dirty
+static void oled_merge_dirty_blocks(void) {
+    OLED_BLOCK_TYPE blocks = oled_dirty & ~oled_dirty_tiled;
+    for (uint8_t block = 0; block < OLED_BLOCK_COUNT; ++block) {
+        if (blocks & ((OLED_BLOCK_TYPE)1 << block)) {
+            oled_mark_dirty_tiles(block * OLED_BLOCK_SIZE, OLED_BLOCK_SIZE);
+        }
+    }
+}
+
+// Rebuilds the block mask from the tiles that are still dirty, so oled_dirty keeps its meaning for callers
+static void oled_sync_dirty_blocks(void) {
+    oled_dirty = 0;
+    for (uint16_t tile = 0; tile < OLED_PAGE_COUNT * OLED_DIRTY_TILE_COUNT; ++tile) {
+        if (oled_dirty_tiles[tile / OLED_DIRTY_TILE_COUNT] & ((OLED_DIRTY_TILE_TYPE)1 << (tile % OLED_DIRTY_TILE_COUNT))) {
+            oled_dirty |= oled_dirty_blocks(tile * OLED_DIRTY_TILE_WIDTH, OLED_DIRTY_TILE_WIDTH);
+        }
+    }
+    oled_dirty_tiled = oled_dirty;
+}
+#endif
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
@@ -452,9 +585,22 @@ void oled_render_dirty(bool all) {
     // Turn on display if it is off
     oled_on();
 
+#ifdef OLED_DIRTY_TILE_WIDTH
+    // Rotated rendering transposes whole blocks, so the tile map is only used when not rotated by 90 degrees
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_merge_dirty_blocks();
+        oled_render_tiles(all);
+        oled_sync_dirty_blocks();
+        return;
+    }
+#endif
+
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+#if OLED_UPDATE_TIME_BUDGET > 0
+    uint16_t render_start = timer_read();
+#endif
+    while (oled_dirty && (all || OLED_RENDER_CONTINUE(num_processed, render_start))) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
@@ -525,6 +671,7 @@ void oled_render_dirty(bool all) {
 
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        ++num_processed;
     }
 }
 
@@ -615,10 +762,7 @@ void oled_write_char(const char data, bool invert) {
 
     // Dirty check
     if (memcmp(&oled_temp_buffer, oled_cursor, OLED_FONT_WIDTH)) {
-        uint16_t index = oled_cursor - &oled_buffer[0];
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
-        // Edgecase check if the written data spans the 2 chunks
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
+        oled_mark_dirty(oled_cursor - &oled_buffer[0], OLED_FONT_WIDTH);
     }
 
     // Finally move to the next char
@@ -653,22 +797,27 @@ void oled_pan(bool left) {
             }
         }
     }
-    oled_dirty = OLED_ALL_BLOCKS_MASK;
+    oled_mark_dirty(0, OLED_MATRIX_SIZE);
 }
 
 oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
-    if (start_index > OLED_MATRIX_SIZE) start_index = OLED_MATRIX_SIZE;
     oled_buffer_reader_t ret_reader;
+    // Past the end there is nothing left to read
+    if (start_index >= OLED_MATRIX_SIZE) {
+        ret_reader.current_element         = &oled_buffer[0];
+        ret_reader.remaining_element_count = 0;
+        return ret_reader;
+    }
     ret_reader.current_element         = &oled_buffer[start_index];
     ret_reader.remaining_element_count = OLED_MATRIX_SIZE - start_index;
     return ret_reader;
 }
 
 void oled_write_raw_byte(const char data, uint16_t index) {
-    if (index > OLED_MATRIX_SIZE) index = OLED_MATRIX_SIZE;
+    if (index >= OLED_MATRIX_SIZE) return;
     if (oled_buffer[index] == data) return;
     oled_buffer[index] = data;
-    oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    oled_mark_dirty(index, 1);
 }
 
 void oled_write_raw(const char *data, uint16_t size) {
@@ -678,7 +827,7 @@ void oled_write_raw(const char *data, uint16_t size) {
         uint8_t c = *data++;
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty(i, 1);
     }
 }
 
@@ -698,7 +847,7 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
     if (oled_buffer[index] != data) {
         oled_buffer[index] = data;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        oled_mark_dirty(index, 1);
     }
 }
 
@@ -723,7 +872,7 @@ void oled_write_raw_P(const char *data, uint16_t size) {
         uint8_t c = pgm_read_byte(data++);
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty(i, 1);
     }
 }
 #endif // defined(__AVR__)
@@ -873,7 +1022,7 @@ bool oled_scroll_off(void) {
             return oled_scrolling;
         }
         oled_scrolling = false;
-        oled_dirty     = OLED_ALL_BLOCKS_MASK;
+        oled_mark_dirty(0, OLED_MATRIX_SIZE);
     }
     return !oled_scrolling;
 }
@@ -309,6 +309,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Milliseconds to keep rendering per oled_task() call, replaces OLED_UPDATE_PROCESS_LIMIT when non-zero
+#if !defined(OLED_UPDATE_TIME_BUDGET)
+#    define OLED_UPDATE_TIME_BUDGET 0
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
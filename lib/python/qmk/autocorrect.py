@@ -0,0 +1,340 @@
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Serializes autocorrections into the trie read by `process_autocorrect.c`.
+
+Typos are stored forwards, and every node has an Aho-Corasick failure link to
+the node for the longest suffix of its path that is also a typo prefix. The
+firmware keeps a single trie state that is advanced by each key, following
+failure links when the current node has no child for it.
+
+Nodes are laid out in depth first order, so the first child of a node always
+directly follows it. All offsets are little endian, `LINK` bytes wide.
+
+  Match:  [128 | backspaces] [correction ...] [0]
+  Single: [64 | key] [failure LINK]                         (child follows)
+  Branch: [children] [failure LINK] ([key] [child LINK]) * children
+
+Dictionaries for external flash are laid out in pages instead, see
+`serialize_trie_paged()`, and stored as an image with a header in front.
+
+This module deliberately has no dependency on milc, so it can also be used to
+build test data outside of the CLI.
+"""
+import struct
+import textwrap
+from collections import deque
+from typing import Any, List, Optional, Tuple
+
+KC_A = 4
+KC_SPC = 0x2c
+KC_QUOT = 0x34
+
+TYPO_CHARS = dict([
+    ("'", KC_QUOT),
+    (':', KC_SPC),  # "Word break" character.
+] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'),
+                                                  ord('z') + 1)])  # Characters a-z.
+
+NODE_MATCH = 128
+NODE_SINGLE = 64
+
+FLASH_MAGIC = b'QACD'
+FLASH_VERSION = 1
+# magic, version, link size, min length, max length, trie size, page size, reserved, checksum
+FLASH_HEADER = struct.Struct('<4sBBBBIHHI')
+
+
+class TrieNode:
+    """A node of the typo trie."""
+    def __init__(self) -> None:
+        self.children = {}
+        self.fail: Optional['TrieNode'] = None
+        self.match: Optional[List[int]] = None
+        self.offset = 0
+
+
+def make_trie(autocorrections: List[Tuple[str, str]]) -> TrieNode:
+    """Makes a trie from the typos, with failure links.
+  Args:
+    autocorrections: List of (typo, correction) tuples.
+  Returns:
+    The root node.
+  """
+    root = TrieNode()
+    for typo, correction in autocorrections:
+        node = root
+        for letter in typo:
+            node = node.children.setdefault(letter, TrieNode())
+        node.match = match_data(typo, correction)
+
+    # Breadth first, so the failure links of shallower nodes are already set.
+    root.fail = root
+    queue = deque()
+    for child in root.children.values():
+        child.fail = root
+        queue.append(child)
+    while queue:
+        node = queue.popleft()
+        if node.match and node.children:
+            raise ValueError('Typos may not be substrings of one another')
+        for letter, child in node.children.items():
+            fail = node.fail
+            while letter not in fail.children and fail is not root:
+                fail = fail.fail
+            child.fail = fail.children.get(letter, root)
+            queue.append(child)
+
+    return root
+
+
+def match_data(typo: str, correction: str) -> List[int]:
+    """Makes the data of the match node for a typo."""
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    return [backspaces + NODE_MATCH] + list(bytes(correction[i:], 'ascii')) + [0]
+
+
+def node_size(node: TrieNode, link_size: int) -> int:
+    if node.match:
+        return len(node.match)
+    elif len(node.children) == 1:
+        return 1 + link_size
+    return 1 + link_size + len(node.children) * (1 + link_size)
+
+
+def encode_link(node: TrieNode, link_size: int) -> List[int]:
+    """Encodes a node link as `link_size` bytes."""
+    return [(node.offset >> (8 * i)) & 255 for i in range(link_size)]
+
+
+def serialize_trie(root: TrieNode) -> Tuple[List[int], int]:
+    """Serializes the trie and correction data in a form readable by the C code.
+  Args:
+    root: The root node returned by `make_trie()`.
+  Returns:
+    List of ints in the range 0-255, and the size of a link in bytes.
+  """
+    nodes = []
+    stack = [root]
+    while stack:
+        node = stack.pop()
+        nodes.append(node)
+        stack += [node.children[c] for c in sorted(node.children, reverse=True)]
+
+    # Links are widened to 24 bits only for tables that need it.
+    for link_size in (2, 3):
+        byte_offset = 0
+        for node in nodes:
+            node.offset = byte_offset
+            byte_offset += node_size(node, link_size)
+        if byte_offset <= 1 << (8 * link_size):
+            break
+    else:
+        raise ValueError('The autocorrection table is too large, a node link exceeds 16MB limit')
+
+    data = []
+    for node in nodes:
+        if node.match:
+            data += node.match
+        elif len(node.children) == 1:
+            letter = next(iter(node.children))
+            data += [TYPO_CHARS[letter] | NODE_SINGLE] + encode_link(node.fail, link_size)
+        else:
+            data += [len(node.children)] + encode_link(node.fail, link_size)
+            for letter in sorted(node.children):
+                data += [TYPO_CHARS[letter]] + encode_link(node.children[letter], link_size)
+
+    return data, link_size
+
+
+def paged_node_size(node: TrieNode, link_size: int, single: bool) -> int:
+    """Size of a node in a paged trie, where a single child node can only be compact if its child is in the same page."""
+    if node.match:
+        return len(node.match)
+    elif single:
+        return 1 + link_size
+    return 1 + link_size + len(node.children) * (1 + link_size)
+
+
+def subtree_size(node: TrieNode, link_size: int) -> int:
+    """Size of a subtree when it is kept in one page, so all single child nodes are compact."""
+    return paged_node_size(node, link_size, len(node.children) == 1) + sum(subtree_size(child, link_size) for child in node.children.values())
+
+
+def preorder(top: TrieNode, members: Optional[set] = None) -> List[TrieNode]:
+    """Lists the nodes of a subtree depth first, so a single child directly follows its parent."""
+    nodes = []
+    stack = [top]
+    while stack:
+        node = stack.pop()
+        nodes.append(node)
+        stack += [node.children[c] for c in sorted(node.children, reverse=True) if members is None or node.children[c] in members]
+    return nodes
+
+
+def layout_pages(root: TrieNode, page_size: int, link_size: int) -> List[List[TrieNode]]:
+    """Groups the trie nodes into pages of at most `page_size` bytes.
+
+    Subtrees that are too large for a page fill one breadth first from their
+    top, so following a typo down the trie only crosses into another page
+    every few levels, and the subtrees that don't fit are placed later. Those
+    that fit in a page are kept whole and packed into the free space first fit.
+    """
+    pages = []
+    free = []
+    small = []
+    large = deque([root])
+    while large:
+        top = large.popleft()
+        members = set()
+        used = 0
+        # Single child nodes are counted as compact. Room for widening them
+        # into a branch is reserved until it is known where the child goes.
+        reserved = 0
+        widen = 1 + link_size
+        frontier = deque([(top, None)])
+        while frontier:
+            node, parent = frontier.popleft()
+            size = paged_node_size(node, link_size, len(node.children) == 1)
+            if size > page_size:
+                raise ValueError(f'A trie node is larger than the {page_size} byte page size')
+            needed = size + (widen if len(node.children) == 1 else 0)
+            if parent is not None and len(parent.children) == 1:
+                reserved -= widen
+                if used + reserved + needed > page_size:
+                    used += widen
+                    (small if subtree_size(node, link_size) <= page_size else large).append(node)
+                    continue
+            elif node is not top and used + reserved + needed > page_size:
+                (small if subtree_size(node, link_size) <= page_size else large).append(node)
+                continue
+            members.add(node)
+            used += size
+            reserved += needed - size
+            frontier.extend((node.children[c], node) for c in sorted(node.children))
+
+        pages.append(preorder(top, members))
+        free.append(page_size - used)
+
+    small.sort(key=lambda node: subtree_size(node, link_size), reverse=True)
+    for top in small:
+        size = subtree_size(top, link_size)
+        index = next((i for i, room in enumerate(free) if room >= size), None)
+        if index is None:
+            index = len(pages)
+            pages.append([])
+            free.append(page_size)
+        pages[index] += preorder(top)
+        free[index] -= size
+
+    return pages
+
+
+def serialize_trie_paged(root: TrieNode, page_size: int) -> Tuple[List[int], int]:
+    """Serializes the trie so that no node crosses a `page_size` boundary.
+
+    The format is the same as `serialize_trie()`, except that single child
+    nodes whose child is in another page are stored as a branch of one, and
+    pages are padded to `page_size`.
+  Returns:
+    List of ints in the range 0-255, and the size of a link in bytes.
+  """
+    for link_size in (2, 3):
+        pages = layout_pages(root, page_size, link_size)
+        compact = set()
+        for page in pages:
+            for node, following in zip(page, page[1:]):
+                if len(node.children) == 1 and next(iter(node.children.values())) is following:
+                    compact.add(node)
+        for index, page in enumerate(pages):
+            byte_offset = index * page_size
+            for node in page:
+                node.offset = byte_offset
+                byte_offset += paged_node_size(node, link_size, node in compact)
+        if byte_offset <= 1 << (8 * link_size):
+            break
+    else:
+        raise ValueError('The autocorrection table is too large, a node link exceeds 16MB limit')
+
+    data = []
+    for index, page in enumerate(pages):
+        data += [0] * (index * page_size - len(data))
+        for node in page:
+            if node.match:
+                data += node.match
+            elif node in compact:
+                letter = next(iter(node.children))
+                data += [TYPO_CHARS[letter] | NODE_SINGLE] + encode_link(node.fail, link_size)
+            else:
+                data += [len(node.children)] + encode_link(node.fail, link_size)
+                for letter in sorted(node.children):
+                    data += [TYPO_CHARS[letter]] + encode_link(node.children[letter], link_size)
+
+    return data, link_size
+
+
+def fnv1a(data: bytes) -> int:
+    """32 bit FNV-1a hash, the checksum of flash dictionaries."""
+    h = 0x811C9DC5
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def autocorrect_flash_image(autocorrections: List[Tuple[str, str]], page_size: int = 256) -> bytes:
+    """Makes the image of a dictionary for external flash.
+
+    The header takes up the first page, the paged trie follows.
+    """
+    data, link_size = serialize_trie_paged(make_trie(autocorrections), page_size)
+    data = bytes(data)
+    min_length = min(map(typo_len, autocorrections))
+    max_length = max(map(typo_len, autocorrections))
+    header = FLASH_HEADER.pack(FLASH_MAGIC, FLASH_VERSION, link_size, min_length, max_length, len(data), page_size, 0, fnv1a(data))
+    return header + b'\xFF' * (page_size - len(header)) + data
+
+
+def typo_len(e: Tuple[str, str]) -> int:
+    return len(e[0])
+
+
+def to_hex(b: int) -> str:
+    return f'0x{b:02X}'
+
+
+def autocorrect_data_lines(autocorrections: List[Tuple[str, str]], data: Any, link_size: int) -> List[str]:
+    """Makes the body of `autocorrect_data.h`."""
+    min_typo = min(autocorrections, key=typo_len)[0]
+    max_typo = max(autocorrections, key=typo_len)[0]
+
+    lines = [f'// Autocorrection dictionary ({len(autocorrections)} entries):']
+    for typo, correction in autocorrections:
+        lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
+
+    lines.append('')
+    lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
+    lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
+    lines.append(f'#define AUTOCORRECT_LINK_SIZE {link_size}')
+    lines.append(f'#define DICTIONARY_SIZE {len(data)}')
+    lines.append('')
+    lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
+    lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
+    lines.append('};')
+
+    return lines
@@ -24,14 +24,16 @@ Example:
   lenght        -> length
   ouput         -> output
   widht         -> width
+With --flash, a binary image for a dictionary in external flash is made
+instead, to be uploaded to the keyboard without reflashing it.
 For full documentation, see QMK Docs
 """
 
-import textwrap
-from typing import Any, Dict, Iterator, List, Tuple
+from typing import Iterator, List, Tuple
 
 from milc import cli
 
+from qmk.autocorrect import TYPO_CHARS, autocorrect_data_lines, autocorrect_flash_image, make_trie, serialize_trie
 from qmk.commands import dump_lines
 from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
 from qmk.keyboard import keyboard_completer, keyboard_folder
@@ -39,16 +41,6 @@ from qmk.keymap import keymap_completer, locate_keymap
 from qmk.path import normpath
 from qmk.util import maybe_exit
 
-KC_A = 4
-KC_SPC = 0x2c
-KC_QUOT = 0x34
-
-TYPO_CHARS = dict([
-    ("'", KC_QUOT),
-    (':', KC_SPC),  # "Word break" character.
-] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'),
-                                                  ord('z') + 1)])  # Characters a-z.
-
 
 def parse_file(file_name: str) -> List[Tuple[str, str]]:
     """Parses autocorrections dictionary file.
@@ -107,23 +99,6 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
     return autocorrections
 
 
-def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
-    """Makes a trie from the the typos, writing in reverse.
-  Args:
-    autocorrections: List of (typo, correction) tuples.
-  Returns:
-    Dict of dict, representing the trie.
-  """
-    trie = {}
-    for typo, correction in autocorrections:
-        node = trie
-        for letter in typo[::-1]:
-            node = node.setdefault(letter, {})
-        node['LEAF'] = (typo, correction)
-
-    return trie
-
-
 def parse_file_lines(file_name: str) -> Iterator[Tuple[int, str, str]]:
     """Parses lines read from `file_name` into typo-correction pairs."""
 
@@ -165,100 +140,25 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
-    """Serializes trie and correction data in a form readable by the C code.
-  Args:
-    autocorrections: List of (typo, correction) tuples.
-    trie: Dict of dicts.
-  Returns:
-    List of ints in the range 0-255.
-  """
-    table = []
-
-    # Traverse trie in depth first order.
-    def traverse(trie_node):
-        if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
-            table.append(entry)
-        elif len(trie_node) == 1:  # Handle trie node with a single child.
-            c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
-
-            # It's common for a trie to have long chains of single-child nodes. We
-            # find the whole chain so that we can serialize it more efficiently.
-            while len(trie_node) == 1 and 'LEAF' not in trie_node:
-                c, trie_node = next(iter(trie_node.items()))
-                entry['chars'] += c
-
-            table.append(entry)
-            entry['links'] = [traverse(trie_node)]
-        else:  # Handle trie node with multiple children.
-            entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
-            table.append(entry)
-            entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
-
-    traverse(trie)
-
-    def serialize(e: Dict[str, Any]) -> List[int]:
-        if not e['links']:  # Handle a leaf table entry.
-            return e['data']
-        elif len(e['links']) == 1:  # Handle a chain table entry.
-            return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
-        else:  # Handle a branch table entry.
-            data = []
-            for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
-            return data + [0]
-
-    byte_offset = 0
-    for e in table:  # To encode links, first compute byte offset of each entry.
-        e['byte_offset'] = byte_offset
-        byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
-
-    return [b for e in table for b in serialize(e)]  # Serialize final table.
-
-
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
-    byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
-        maybe_exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
-
-
-def typo_len(e: Tuple[str, str]) -> int:
-    return len(e[0])
-
-
-def to_hex(b: int) -> str:
-    return f'0x{b:02X}'
-
-
 @cli.argument('filename', type=normpath, help='The autocorrection database file')
 @cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a output file is supplied.')
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a output file is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-f', '--flash', arg_only=True, action='store_true', help='Generate a binary image for a dictionary in external flash')
+@cli.argument('-p', '--page-size', arg_only=True, type=int, default=256, help='The page size of the external flash. Default is 256.')
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
-    trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+
+    if cli.args.flash:
+        return generate_autocorrect_flash_image(cli, autocorrections)
+
+    try:
+        data, link_size = serialize_trie(make_trie(autocorrections))
+    except ValueError as e:
+        cli.log.error('{fg_red}Error:{fg_reset} %s. Try reducing the autocorrection dict to fewer entries.', e)
+        maybe_exit(1)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -268,24 +168,27 @@ def generate_autocorrect_data(cli):
 
     assert all(0 <= b <= 255 for b in data)
 
-    min_typo = min(autocorrections, key=typo_len)[0]
-    max_typo = max(autocorrections, key=typo_len)[0]
-
     # Build the autocorrect_data.h file.
     autocorrect_data_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
-
-    autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries):')
-    for typo, correction in autocorrections:
-        autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
-
-    autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
-    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
-    autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
-    autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
-    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
-    autocorrect_data_h_lines.append('};')
+    autocorrect_data_h_lines += autocorrect_data_lines(autocorrections, data, link_size)
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
+
+
+def generate_autocorrect_flash_image(cli, autocorrections):
+    """Writes the binary image of a dictionary for external flash."""
+    if not cli.args.output:
+        cli.log.error('{fg_red}Error:{fg_reset} --flash needs an output file.')
+        return False
+
+    try:
+        image = autocorrect_flash_image(autocorrections, cli.args.page_size)
+    except ValueError as e:
+        cli.log.error('{fg_red}Error:{fg_reset} %s.', e)
+        return False
+
+    cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+    cli.args.output.write_bytes(image)
+    if not cli.args.quiet:
+        cli.log.info('Wrote %d byte dictionary image to %s.', len(image), cli.args.output)
@@ -281,6 +281,12 @@ void process_record(keyrecord_t *record) {
     if (IS_NOEVENT(record->event)) {
         return;
     }
+#ifdef DYNAMIC_MACRO_ENABLE
+    // Before any of the processing below, which then happens once as the event is replayed
+    if (dynamic_macro_hold_back(record)) {
+        return;
+    }
+#endif
 #ifdef SPECULATIVE_HOLD
     if (record->event.pressed) {
         speculative_key_settled(record);
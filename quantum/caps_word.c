@@ -17,6 +17,7 @@
 #include "timer.h"
 #include "action.h"
 #include "action_util.h"
+#include "deadline.h"
 
 /** @brief True when Caps Word is active. */
 static bool caps_word_active = false;
@@ -39,6 +40,7 @@ void caps_word_task(void) {
 
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
+    deadline_set(DEADLINE_CAPS_WORD, timer_read32() + CAPS_WORD_IDLE_TIMEOUT, caps_word_task);
 }
 #else
 void caps_word_task(void) {}
@@ -68,6 +70,7 @@ void caps_word_off(void) {
 
     unregister_weak_mods(MOD_MASK_SHIFT); // Make sure weak shift is off.
     caps_word_active = false;
+    deadline_cancel(DEADLINE_CAPS_WORD);
     caps_word_set_user(false);
 }
 
@@ -0,0 +1,62 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "deadline.h"
+#include "timer.h"
+#include "compiler_support.h"
+
+STATIC_ASSERT(DEADLINE_COUNT <= 8, "Too many deadlines for the pending mask");
+
+static uint32_t            deadlines[DEADLINE_COUNT];
+static deadline_callback_t callbacks[DEADLINE_COUNT];
+static uint8_t             pending  = 0;
+static uint32_t            earliest = 0;
+
+static void deadline_update_earliest(void) {
+    bool found = false;
+    for (uint8_t i = 0; i < DEADLINE_COUNT; i++) {
+        // Comparing as the distance from the current earliest keeps working across the timer wrapping around
+        if ((pending & (1 << i)) && (!found || (int32_t)TIMER_DIFF_32(deadlines[i], earliest) < 0)) {
+            earliest = deadlines[i];
+            found    = true;
+        }
+    }
+}
+
+void deadline_set(deadline_id_t id, uint32_t deadline, deadline_callback_t callback) {
+    deadlines[id] = deadline;
+    callbacks[id] = callback;
+    pending |= 1 << id;
+    deadline_update_earliest();
+}
+
+void deadline_cancel(deadline_id_t id) {
+    if (pending & (1 << id)) {
+        pending &= ~(1 << id);
+        deadline_update_earliest();
+    }
+}
+
+bool deadline_pending(deadline_id_t id) {
+    return pending & (1 << id);
+}
+
+void deadline_task(void) {
+    if (!pending) {
+        return;
+    }
+
+    uint32_t now = timer_read32();
+    if (!timer_expired32(now, earliest)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < DEADLINE_COUNT; i++) {
+        if ((pending & (1 << i)) && timer_expired32(now, deadlines[i])) {
+            // Cleared first, so that the callback may set a new deadline
+            pending &= ~(1 << i);
+            callbacks[i]();
+        }
+    }
+    deadline_update_earliest();
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @enum Core features with a timeout, each has at most one deadline pending.
+ *
+ * Deadlines that are due at the same time fire in this order.
+ */
+typedef enum {
+#ifdef TAP_DANCE_ENABLE
+    DEADLINE_TAP_DANCE,
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    DEADLINE_KEY_OVERRIDE,
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    DEADLINE_AUTO_SHIFT,
+#endif
+#ifdef CAPS_WORD_ENABLE
+    DEADLINE_CAPS_WORD,
+#endif
+#ifdef SECURE_ENABLE
+    DEADLINE_SECURE,
+#endif
+#ifdef LAYER_LOCK_ENABLE
+    DEADLINE_LAYER_LOCK,
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    DEADLINE_DYNAMIC_MACRO,
+#endif
+    DEADLINE_COUNT,
+} deadline_id_t;
+
+/**
+ * @typedef Callback invoked once its deadline has passed.
+ */
+typedef void (*deadline_callback_t)(void);
+
+/**
+ * Sets the deadline of a feature, replacing the one it had pending.
+ *
+ * @param id[in] the feature the deadline belongs to
+ * @param deadline[in] when to invoke the callback -- equivalent time-space as timer_read32()
+ * @param callback[in] the function to invoke once the deadline has passed
+ */
+void deadline_set(deadline_id_t id, uint32_t deadline, deadline_callback_t callback);
+
+/**
+ * Drops the pending deadline of a feature, if any.
+ *
+ * @param id[in] the feature the deadline belongs to
+ */
+void deadline_cancel(deadline_id_t id);
+
+/**
+ * @param id[in] the feature the deadline belongs to
+ * @return true if the feature has a deadline pending
+ */
+bool deadline_pending(deadline_id_t id);
+
+/**
+ * Invokes the callbacks whose deadlines have passed. Only compares the time against the earliest deadline otherwise.
+ */
+void deadline_task(void);
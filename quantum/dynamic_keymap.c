@@ -167,5 +167,13 @@ void dynamic_keymap_macro_send(uint8_t id) {
     }
 
     send_string_nvm_state_t state = {.offset = offset};
+#if defined(SEND_STRING_ASYNC_QUEUE_SIZE) && DYNAMIC_KEYMAP_MACRO_DELAY == 0
+    // the queue sends at its own interval, so a macro delay means typing it out directly
+    if (send_string_async_impl(send_string_get_next_nvm, &state)) {
+        return;
+    }
+    // too long for the queue, fall back to typing it out directly
+    state.offset = offset;
+#endif
     send_string_with_delay_impl(send_string_get_next_nvm, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
@@ -140,6 +140,14 @@ void eeconfig_init_quantum(void) {
     eeconfig_update_connection_default();
 #endif // CONNECTION_ENABLE
 
+#if (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+    eeconfig_init_rgb_matrix_key_stats();
+#endif // (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    eeconfig_init_dynamic_macro();
+#endif // (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+
 #if (EECONFIG_KB_DATA_SIZE) > 0
     eeconfig_init_kb_datablock();
 #endif // (EECONFIG_KB_DATA_SIZE) > 0
@@ -267,6 +275,30 @@ void eeconfig_update_rgb_matrix(const rgb_config_t *rgb_matrix_config) {
 }
 #endif // RGB_MATRIX_ENABLE
 
+#if (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+void eeconfig_read_rgb_matrix_key_stats(uint16_t *counts) {
+    nvm_eeconfig_read_rgb_matrix_key_stats(counts);
+}
+void eeconfig_update_rgb_matrix_key_stats(const uint16_t *counts) {
+    nvm_eeconfig_update_rgb_matrix_key_stats(counts);
+}
+void eeconfig_init_rgb_matrix_key_stats(void) {
+    nvm_eeconfig_init_rgb_matrix_key_stats();
+}
+#endif // (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+uint32_t eeconfig_read_dynamic_macro(void *data, uint32_t offset, uint32_t length) {
+    return nvm_eeconfig_read_dynamic_macro(data, offset, length);
+}
+uint32_t eeconfig_update_dynamic_macro(const void *data, uint32_t offset, uint32_t length) {
+    return nvm_eeconfig_update_dynamic_macro(data, offset, length);
+}
+void eeconfig_init_dynamic_macro(void) {
+    nvm_eeconfig_init_dynamic_macro();
+}
+#endif // (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+
 #ifdef LED_MATRIX_ENABLE
 void eeconfig_read_led_matrix(led_eeconfig_t *led_matrix_config) {
     nvm_eeconfig_read_led_matrix(led_matrix_config);
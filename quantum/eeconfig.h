@@ -36,6 +36,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EECONFIG_USER_DATA_VERSION (EECONFIG_USER_DATA_SIZE)
 #endif
 
+// Size of EEPROM dedicated to RGB Matrix key press statistics
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_KEY_STATS)
+#    define EECONFIG_RGB_MATRIX_KEY_STATS_SIZE (MATRIX_ROWS * MATRIX_COLS * 2)
+#else
+#    define EECONFIG_RGB_MATRIX_KEY_STATS_SIZE 0
+#endif
+
+// Size of EEPROM dedicated to persisted Dynamic Macros
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_NVM_SIZE)
+#    define EECONFIG_DYNAMIC_MACRO_SIZE (DYNAMIC_MACRO_NVM_SIZE)
+#else
+#    define EECONFIG_DYNAMIC_MACRO_SIZE 0
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
@@ -103,6 +117,18 @@ void                       eeconfig_read_rgb_matrix(rgb_config_t *rgb_matrix_con
 void                       eeconfig_update_rgb_matrix(const rgb_config_t *rgb_matrix_config) __attribute__((nonnull));
 #endif // RGB_MATRIX_ENABLE
 
+#if (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+void eeconfig_read_rgb_matrix_key_stats(uint16_t *counts) __attribute__((nonnull));
+void eeconfig_update_rgb_matrix_key_stats(const uint16_t *counts) __attribute__((nonnull));
+void eeconfig_init_rgb_matrix_key_stats(void);
+#endif // (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+uint32_t eeconfig_read_dynamic_macro(void *data, uint32_t offset, uint32_t length) __attribute__((nonnull));
+uint32_t eeconfig_update_dynamic_macro(const void *data, uint32_t offset, uint32_t length) __attribute__((nonnull));
+void     eeconfig_init_dynamic_macro(void);
+#endif // (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+
 #ifdef LED_MATRIX_ENABLE
 typedef union led_eeconfig_t led_eeconfig_t;
 void                         eeconfig_read_led_matrix(led_eeconfig_t *led_matrix_config) __attribute__((nonnull));
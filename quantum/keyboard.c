@@ -151,6 +151,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#ifdef DEADLINE_ENABLE
+#    include "deadline.h"
+#endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_QUEUE_SIZE)
+#    include "send_string.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -660,18 +666,10 @@ void quantum_task(void) {
     music_task();
 #endif
 
-#ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
-#endif
-
 #ifdef SEQUENCER_ENABLE
     sequencer_task();
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
-#endif
-
 #ifdef COMBO_ENABLE
     combo_task();
 #endif
@@ -688,20 +686,13 @@ void quantum_task(void) {
     dip_switch_task();
 #endif
 
-#ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
-#endif
-
-#ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+#ifdef DEADLINE_ENABLE
+    // Tap Dance, Key Override, Auto Shift, Caps Word, Secure and Layer Lock timeouts, and dynamic macro playback
+    deadline_task();
 #endif
 
-#ifdef SECURE_ENABLE
-    secure_task();
-#endif
-
-#ifdef LAYER_LOCK_ENABLE
-    layer_lock_task();
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_QUEUE_SIZE)
+    send_string_task();
 #endif
 
     host_task();
@@ -147,6 +147,12 @@ __attribute__((weak)) tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx)
     return tap_dance_get_raw(tap_dance_idx);
 }
 
+static uint8_t tap_dance_slot_buffer[ARRAY_SIZE(tap_dance_actions)];
+
+uint8_t* tap_dance_slot_buffer_raw(void) {
+    return tap_dance_slot_buffer;
+}
+
 #endif // defined(TAP_DANCE_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -175,8 +181,59 @@ __attribute__((weak)) const key_override_t* key_override_get(uint16_t key_overri
     return key_override_get_raw(key_override_idx);
 }
 
+static uint8_t key_override_index_buffer[ARRAY_SIZE(key_overrides)];
+
+uint8_t* key_override_index_buffer_raw(void) {
+    return key_override_index_buffer;
+}
+
 #endif // defined(KEY_OVERRIDE_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+uint16_t leader_sequences_count_raw(void) {
+    return ARRAY_SIZE(leader_sequences);
+}
+
+__attribute__((weak)) uint16_t leader_sequences_count(void) {
+    return leader_sequences_count_raw();
+}
+
+STATIC_ASSERT(ARRAY_SIZE(leader_sequences) <= UINT8_MAX, "Number of leader sequences exceeds maximum of 255");
+
+uint16_t leader_sequences_key_at_raw(uint16_t sequence_idx, uint8_t position) {
+    if (sequence_idx < leader_sequences_count_raw() && position < LEADER_SEQUENCE_MAX_LENGTH) {
+        return pgm_read_word(&leader_sequences[sequence_idx].keys[position]);
+    }
+    return KC_NO;
+}
+
+__attribute__((weak)) uint16_t leader_sequences_key_at(uint16_t sequence_idx, uint8_t position) {
+    return leader_sequences_key_at_raw(sequence_idx, position);
+}
+
+uint16_t leader_sequences_keycode_raw(uint16_t sequence_idx) {
+    if (sequence_idx < leader_sequences_count_raw()) {
+        return pgm_read_word(&leader_sequences[sequence_idx].keycode);
+    }
+    return KC_NO;
+}
+
+__attribute__((weak)) uint16_t leader_sequences_keycode(uint16_t sequence_idx) {
+    return leader_sequences_keycode_raw(sequence_idx);
+}
+
+static uint8_t leader_sequences_index_buffer[ARRAY_SIZE(leader_sequences)];
+
+uint8_t* leader_sequences_index_buffer_raw(void) {
+    return leader_sequences_index_buffer;
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Community modules (must be last in this file!)
 
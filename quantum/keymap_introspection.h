@@ -87,6 +87,9 @@ tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx);
 // Get the tap dance definitions, potentially stored dynamically
 tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
 
+// Get the scratch space for the state slot of each tap dance, with room for `tap_dance_count_raw()` entries
+uint8_t* tap_dance_slot_buffer_raw(void);
+
 #endif // defined(TAP_DANCE_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -108,4 +111,32 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 // Get the key override definitions, potentially stored dynamically
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
+// Get the scratch space for the trigger index of key overrides, with room for `key_override_count_raw()` entries
+uint8_t* key_override_index_buffer_raw(void);
+
 #endif // defined(KEY_OVERRIDE_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+// Get the number of leader sequences defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t leader_sequences_count_raw(void);
+// Get the number of leader sequences defined in the user's keymap, potentially stored dynamically
+uint16_t leader_sequences_count(void);
+
+// Get a key of a leader sequence, KC_NO past its end, stored in firmware rather than any other persistent storage
+uint16_t leader_sequences_key_at_raw(uint16_t sequence_idx, uint8_t position);
+// Get a key of a leader sequence, KC_NO past its end, potentially stored dynamically
+uint16_t leader_sequences_key_at(uint16_t sequence_idx, uint8_t position);
+
+// Get the keycode tapped by a leader sequence, stored in firmware rather than any other persistent storage
+uint16_t leader_sequences_keycode_raw(uint16_t sequence_idx);
+// Get the keycode tapped by a leader sequence, potentially stored dynamically
+uint16_t leader_sequences_keycode(uint16_t sequence_idx);
+
+// Get the scratch space for the sorted index of leader sequences, with room for `leader_sequences_count_raw()` entries
+uint8_t* leader_sequences_index_buffer_raw(void);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
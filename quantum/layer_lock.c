@@ -14,6 +14,7 @@
 
 #include "layer_lock.h"
 #include "quantum_keycodes.h"
+#include "deadline.h"
 
 #ifndef NO_ACTION_LAYER
 // The current lock state. The kth bit is on if layer k is locked.
@@ -29,10 +30,22 @@ void layer_lock_timeout_task(void) {
         layer_lock_timer = timer_read32();
     }
 }
+
+// Times out while any layer is locked
+static void layer_lock_schedule_timeout(void) {
+    if (locked_layers) {
+        deadline_set(DEADLINE_LAYER_LOCK, layer_lock_timer + LAYER_LOCK_IDLE_TIMEOUT + 1, layer_lock_timeout_task);
+    } else {
+        deadline_cancel(DEADLINE_LAYER_LOCK);
+    }
+}
+
 void layer_lock_activity_trigger(void) {
     layer_lock_timer = timer_read32();
+    layer_lock_schedule_timeout();
 }
 #    else
+static void layer_lock_schedule_timeout(void) {}
 void layer_lock_timeout_task(void) {}
 void layer_lock_activity_trigger(void) {}
 #    endif // LAYER_LOCK_IDLE_TIMEOUT > 0
@@ -55,6 +68,7 @@ void layer_lock_invert(uint8_t layer) {
         layer_off(layer);
     }
     layer_lock_set_kb(locked_layers ^= mask);
+    layer_lock_schedule_timeout();
 }
 
 // Implement layer_lock_on/off by deferring to layer_lock_invert.
@@ -73,6 +87,7 @@ void layer_lock_off(uint8_t layer) {
 void layer_lock_all_off(void) {
     layer_and(~locked_layers);
     locked_layers = 0;
+    layer_lock_schedule_timeout();
     layer_lock_set_kb(locked_layers);
 }
 
@@ -7,15 +7,30 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCES_ENABLE
+#    include "quantum.h"
+#    include "keymap_introspection.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                     = false;
+uint16_t leader_time                                 = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX_LENGTH] = {0, 0, 0, 0, 0};
+uint8_t  leader_sequence_size                        = 0;
+
+#ifdef LEADER_SEQUENCES_ENABLE
+// The sequences of the table sorted by their keys, which makes it a trie flattened in depth first order: the sequences
+// starting with the keys typed so far are the range from `sequences_low` to `sequences_high`, which narrows with every
+// key. A sequence sorts before the longer ones it is the start of.
+static uint8_t *sequences_index       = NULL;
+static uint8_t  sequences_index_count = 0;
+static uint8_t  sequences_low         = 0;
+static uint8_t  sequences_high        = 0;
+#endif
 
 __attribute__((weak)) void leader_start_user(void) {}
 
@@ -25,6 +40,76 @@ __attribute__((weak)) bool leader_add_user(uint16_t keycode) {
     return false;
 }
 
+#ifdef LEADER_SEQUENCES_ENABLE
+__attribute__((weak)) bool leader_sequence_matched_user(uint16_t index) {
+    return true;
+}
+
+static bool leader_sequences_less(uint8_t a, uint8_t b) {
+    for (uint8_t i = 0; i < LEADER_SEQUENCE_MAX_LENGTH; i++) {
+        uint16_t key_a = leader_sequences_key_at(a, i);
+        uint16_t key_b = leader_sequences_key_at(b, i);
+        if (key_a != key_b) {
+            return key_a < key_b;
+        }
+    }
+    return false;
+}
+
+static void leader_sequences_build_index(void) {
+    // Sequences past the ones in the keymap have no room in the index
+    uint8_t count = MIN(leader_sequences_count(), leader_sequences_count_raw());
+    if (sequences_index != NULL && sequences_index_count == count) {
+        return;
+    }
+
+    sequences_index = leader_sequences_index_buffer_raw();
+    for (sequences_index_count = 0; sequences_index_count < count; sequences_index_count++) {
+        // Insertion sort, which keeps identical sequences in the order of the table
+        uint8_t position = sequences_index_count;
+        while (position > 0 && leader_sequences_less(sequences_index_count, sequences_index[position - 1])) {
+            sequences_index[position] = sequences_index[position - 1];
+            position--;
+        }
+        sequences_index[position] = sequences_index_count;
+    }
+}
+
+// First position from `sequences_low` whose key at `depth` is not below `keycode`
+static uint8_t leader_sequences_lower_bound(uint8_t depth, uint32_t keycode) {
+    uint8_t low  = sequences_low;
+    uint8_t high = sequences_high;
+    while (low < high) {
+        uint8_t middle = low + (high - low) / 2;
+        if (leader_sequences_key_at(sequences_index[middle], depth) < keycode) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Whether the keys typed so far are a whole sequence of the table
+static bool leader_sequences_matched(void) {
+    return leader_sequence_size > 0 && sequences_low < sequences_high && leader_sequences_key_at(sequences_index[sequences_low], leader_sequence_size) == KC_NO;
+}
+
+/**
+ * Narrows the sequences down to the ones starting with the keys typed so far.
+ *
+ * \return `true` if the sequence is complete: nothing can match anymore, or it is a sequence that no other one starts with.
+ */
+static bool leader_sequences_step(uint16_t keycode) {
+    uint8_t depth  = leader_sequence_size - 1;
+    uint8_t low    = leader_sequences_lower_bound(depth, keycode);
+    sequences_high = leader_sequences_lower_bound(depth, (uint32_t)keycode + 1);
+    sequences_low  = low;
+
+    return sequences_low == sequences_high || (leader_sequences_matched() && sequences_high - sequences_low == 1);
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -34,10 +119,23 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_SEQUENCES_ENABLE
+    leader_sequences_build_index();
+    sequences_low  = 0;
+    sequences_high = sequences_index_count;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCES_ENABLE
+    if (leader_sequences_matched()) {
+        uint8_t index = sequences_index[sequences_low];
+        if (leader_sequence_matched_user(index) && leader_sequences_keycode(index) != KC_NO) {
+            tap_code16(leader_sequences_keycode(index));
+        }
+    }
+#endif
     leader_end_user();
 }
 
@@ -65,7 +163,13 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
-    if (leader_add_user(keycode)) {
+#ifdef LEADER_SEQUENCES_ENABLE
+    bool complete = leader_sequences_step(keycode);
+#else
+    bool complete = false;
+#endif
+
+    if (leader_add_user(keycode) || complete) {
         leader_end();
     }
     return true;
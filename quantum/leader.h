@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,24 @@
  * \{
  */
 
+/**
+ * The longest sequence the leader key takes.
+ */
+#define LEADER_SEQUENCE_MAX_LENGTH 5
+
+/**
+ * \brief An entry of the `leader_sequences` table, see `LEADER_SEQUENCE()`.
+ */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_MAX_LENGTH];
+    uint16_t keycode;
+} leader_sequence_t;
+
+/**
+ * \brief Declares a sequence of up to five keys that taps `keycode`, e.g. `LEADER_SEQUENCE(KC_HOME, KC_G, KC_G)`.
+ */
+#define LEADER_SEQUENCE(keycode_, ...) {.keys = {__VA_ARGS__}, .keycode = (keycode_)}
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -30,6 +50,15 @@ void leader_end_user(void);
  */
 bool leader_add_user(uint16_t keycode);
 
+/**
+ * \brief User callback, invoked when the sequence typed is one of the `leader_sequences` table.
+ *
+ * \param index The index of the sequence in the table.
+ *
+ * \return `true` to tap the keycode of the sequence, `false` to skip it.
+ */
+bool leader_sequence_matched_user(uint16_t index);
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
@@ -30,6 +30,19 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    define LED_RENDER_TIMESTAMP() ((uint32_t)chVTGetSystemTimeX())
+#    define LED_RENDER_ELAPSED_US(start) ((uint32_t)TIME_I2US(chVTTimeElapsedSinceX((systime_t)(start))))
+#else
+// Only the millisecond timer is available, so render steps are measured in whole milliseconds
+#    define LED_RENDER_TIMESTAMP() timer_read32()
+#    define LED_RENDER_ELAPSED_US(start) (timer_elapsed32(start) * 1000)
+#    if LED_MATRIX_RENDER_BUDGET_US > 0 && LED_MATRIX_RENDER_BUDGET_US < 1000
+#        error "LED_MATRIX_RENDER_BUDGET_US must be at least 1000 on platforms without a microsecond timer"
+#    endif
+#endif
+
 #ifndef LED_MATRIX_CENTER
 const led_point_t k_led_matrix_center = {112, 32};
 #else
@@ -84,6 +97,17 @@ static uint8_t         led_current_effect = 0;
 static effect_params_t led_effect_params  = {0, LED_FLAG_ALL, false};
 static led_task_states led_task_state     = SYNCING;
 
+// render scheduling
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+static struct led_matrix_limits_t led_render_limits;
+static uint8_t                    led_render_chunk    = MAX(LED_MATRIX_LED_PROCESS_LIMIT, 1);
+static uint32_t                   led_render_led_cost = 0; // average cost of one LED, in 1/16 microseconds
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+static uint32_t                  led_render_stats_timer;
+static uint16_t                  led_render_frames;
+static uint16_t                  led_render_worst_us;
+static led_matrix_render_stats_t led_render_stats;
+
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
@@ -252,8 +276,25 @@ static void led_task_timers(void) {
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
+static void led_task_stats(void) {
+    uint32_t elapsed = timer_elapsed32(led_render_stats_timer);
+    if (elapsed < 1000) return;
+
+    led_render_stats.fps            = (uint32_t)led_render_frames * 1000 / elapsed;
+    led_render_stats.worst_chunk_us = led_render_worst_us;
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+    led_render_stats.chunk_size = led_render_chunk;
+#else
+    led_render_stats.chunk_size = MIN(LED_MATRIX_LED_PROCESS_LIMIT, LED_MATRIX_LED_COUNT);
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+    led_render_stats_timer = timer_read32();
+    led_render_frames      = 0;
+    led_render_worst_us    = 0;
+}
+
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
+    led_task_stats();
     // next task
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
@@ -283,8 +324,35 @@ static void led_task_start(void) {
     led_task_state = RENDERING;
 }
 
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+static void led_task_render_limits(uint8_t iter) {
+#    if defined(LED_MATRIX_SPLIT)
+    uint8_t first = is_keyboard_left() ? 0 : k_led_matrix_split[0];
+    uint8_t last  = is_keyboard_left() ? k_led_matrix_split[0] : LED_MATRIX_LED_COUNT;
+#    else
+    uint8_t first = 0;
+    uint8_t last  = LED_MATRIX_LED_COUNT;
+#    endif
+    led_render_limits.led_min_index = iter == 0 ? first : led_render_limits.led_max_index;
+    led_render_limits.led_max_index = MIN((uint16_t)led_render_limits.led_min_index + led_render_chunk, last);
+}
+
+static void led_task_render_adapt(uint32_t elapsed_us) {
+    uint8_t leds = led_render_limits.led_max_index - led_render_limits.led_min_index;
+    if (leds == 0) return;
+
+    // smooth the measured cost per LED, then size the next step to fit the budget
+    led_render_led_cost = (led_render_led_cost * 3 + (elapsed_us << 4) / leds) / 4;
+    uint32_t chunk      = ((uint32_t)LED_MATRIX_RENDER_BUDGET_US << 4) / MAX(led_render_led_cost, 1);
+    led_render_chunk    = MAX(MIN(chunk, LED_MATRIX_LED_COUNT), 1);
+}
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+
 static void led_task_render(uint8_t effect) {
     bool rendering         = false;
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+    led_task_render_limits(led_effect_params.iter);
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
     led_effect_params.init = (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
     if (led_effect_params.flags != led_matrix_eeconfig.flags) {
         led_effect_params.flags = led_matrix_eeconfig.flags;
@@ -349,6 +417,7 @@ static void led_task_flush(uint8_t effect) {
     // update last trackers after the first full render so we can init over several frames
     led_last_effect = effect;
     led_last_enable = led_matrix_eeconfig.enable;
+    led_render_frames++;
 
     // update pwm buffers
     led_matrix_update_pwm_buffers();
@@ -366,7 +435,8 @@ void led_matrix_task(void) {
         case STARTING:
             led_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+            uint32_t render_start = LED_RENDER_TIMESTAMP();
             led_task_render(effect);
             if (effect) {
                 if (led_task_state == FLUSHING) {
@@ -374,7 +444,12 @@ void led_matrix_task(void) {
                 }
                 led_matrix_indicators_advanced(&led_effect_params);
             }
-            break;
+            uint32_t elapsed_us = LED_RENDER_ELAPSED_US(render_start);
+            led_render_worst_us = MAX(led_render_worst_us, MIN(elapsed_us, UINT16_MAX));
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+            led_task_render_adapt(elapsed_us);
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+        } break;
         case FLUSHING:
             led_task_flush(effect);
             break;
@@ -426,7 +501,10 @@ __attribute__((weak)) bool led_matrix_indicators_advanced_user(uint8_t led_min,
 
 struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     struct led_matrix_limits_t limits = {0};
-#if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+    // step sizes change at runtime, so these are always the limits of the step being rendered
+    limits = led_render_limits;
+#elif defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
 #    if defined(LED_MATRIX_SPLIT)
     limits.led_min_index = LED_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + LED_MATRIX_LED_PROCESS_LIMIT;
@@ -489,6 +567,10 @@ bool led_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+led_matrix_render_stats_t led_matrix_get_render_stats(void) {
+    return led_render_stats;
+}
+
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
     led_task_state = STARTING;
@@ -62,6 +62,10 @@
 #    define LED_MATRIX_DEFAULT_FLAGS LED_FLAG_ALL
 #endif
 
+#if !defined(LED_MATRIX_LED_FLUSH_LIMIT) && defined(LED_MATRIX_TARGET_FPS)
+#    define LED_MATRIX_LED_FLUSH_LIMIT (1000 / LED_MATRIX_TARGET_FPS)
+#endif
+
 #ifndef LED_MATRIX_LED_FLUSH_LIMIT
 #    define LED_MATRIX_LED_FLUSH_LIMIT 16
 #endif
@@ -70,6 +74,11 @@
 #    define LED_MATRIX_LED_PROCESS_LIMIT ((LED_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+// When non-zero, the number of LEDs rendered per task run is adjusted at runtime to fit this many microseconds
+#ifndef LED_MATRIX_RENDER_BUDGET_US
+#    define LED_MATRIX_RENDER_BUDGET_US 0
+#endif
+
 struct led_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -77,6 +86,14 @@ struct led_matrix_limits_t {
 
 struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter);
 
+typedef struct {
+    uint16_t fps;            // frames rendered during the last second
+    uint16_t worst_chunk_us; // slowest single render step during the last second
+    uint8_t  chunk_size;     // number of LEDs currently rendered per step
+} led_matrix_render_stats_t;
+
+led_matrix_render_stats_t led_matrix_get_render_stats(void);
+
 #define LED_MATRIX_USE_LIMITS_ITER(min, max, iter)                   \
     struct led_matrix_limits_t limits = led_matrix_get_limits(iter); \
     uint8_t                    min    = limits.led_min_index;        \
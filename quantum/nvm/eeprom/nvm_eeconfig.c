@@ -4,6 +4,7 @@
 #include "nvm_eeconfig.h"
 #include "nvm_eeprom_eeconfig_internal.h"
 #include "util.h"
+#include "compiler_support.h"
 #include "eeconfig.h"
 #include "debug.h"
 #include "eeprom.h"
@@ -173,6 +174,48 @@ void nvm_eeconfig_update_rgblight(const rgblight_config_t *rgblight_config) {
 }
 #endif // RGBLIGHT_ENABLE
 
+#if (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+void nvm_eeconfig_read_rgb_matrix_key_stats(uint16_t *counts) {
+    eeprom_read_block(counts, EECONFIG_RGB_MATRIX_KEY_STATS, EECONFIG_RGB_MATRIX_KEY_STATS_SIZE);
+}
+void nvm_eeconfig_update_rgb_matrix_key_stats(const uint16_t *counts) {
+    eeprom_update_block(counts, EECONFIG_RGB_MATRIX_KEY_STATS, EECONFIG_RGB_MATRIX_KEY_STATS_SIZE);
+}
+void nvm_eeconfig_init_rgb_matrix_key_stats(void) {
+    void   *start     = (void *)(uintptr_t)(EECONFIG_RGB_MATRIX_KEY_STATS);
+    long    remaining = EECONFIG_RGB_MATRIX_KEY_STATS_SIZE;
+    uint8_t dummy[16] = {0};
+    while (remaining > 0) {
+        int this_loop = remaining < sizeof(dummy) ? remaining : sizeof(dummy);
+        eeprom_update_block(dummy, start, this_loop);
+        start += this_loop;
+        remaining -= this_loop;
+    }
+}
+#endif // (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+STATIC_ASSERT((uintptr_t)(EECONFIG_DYNAMIC_MACRO) + (EECONFIG_DYNAMIC_MACRO_SIZE) <= (TOTAL_EEPROM_BYTE_COUNT), "DYNAMIC_MACRO_NVM_SIZE is configured to use more space than what is available for the selected EEPROM driver");
+
+uint32_t nvm_eeconfig_read_dynamic_macro(void *data, uint32_t offset, uint32_t length) {
+    void *ee_start = (void *)(uintptr_t)(EECONFIG_DYNAMIC_MACRO + offset);
+    void *ee_end   = (void *)(uintptr_t)(EECONFIG_DYNAMIC_MACRO + MIN(EECONFIG_DYNAMIC_MACRO_SIZE, offset + length));
+    eeprom_read_block(data, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+}
+uint32_t nvm_eeconfig_update_dynamic_macro(const void *data, uint32_t offset, uint32_t length) {
+    void *ee_start = (void *)(uintptr_t)(EECONFIG_DYNAMIC_MACRO + offset);
+    void *ee_end   = (void *)(uintptr_t)(EECONFIG_DYNAMIC_MACRO + MIN(EECONFIG_DYNAMIC_MACRO_SIZE, offset + length));
+    eeprom_update_block(data, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+}
+void nvm_eeconfig_init_dynamic_macro(void) {
+    // Only the lengths at the start need clearing for the macros to be empty
+    uint16_t empty[2] = {0, 0};
+    eeprom_update_block(empty, EECONFIG_DYNAMIC_MACRO, sizeof(empty));
+}
+#endif // (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+
 #if (EECONFIG_KB_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_kb(void) {
     return eeprom_read_dword(EECONFIG_KEYBOARD);
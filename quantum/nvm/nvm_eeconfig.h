@@ -71,6 +71,18 @@ void                            nvm_eeconfig_read_rgblight(rgblight_config_t *rg
 void                            nvm_eeconfig_update_rgblight(const rgblight_config_t *rgblight_config);
 #endif // RGBLIGHT_ENABLE
 
+#if (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+void nvm_eeconfig_read_rgb_matrix_key_stats(uint16_t *counts);
+void nvm_eeconfig_update_rgb_matrix_key_stats(const uint16_t *counts);
+void nvm_eeconfig_init_rgb_matrix_key_stats(void);
+#endif // (EECONFIG_RGB_MATRIX_KEY_STATS_SIZE) > 0
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+uint32_t nvm_eeconfig_read_dynamic_macro(void *data, uint32_t offset, uint32_t length);
+uint32_t nvm_eeconfig_update_dynamic_macro(const void *data, uint32_t offset, uint32_t length);
+void     nvm_eeconfig_init_dynamic_macro(void);
+#endif // (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+
 #if (EECONFIG_KB_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_kb(void);
 void     nvm_eeconfig_update_kb(uint32_t val);
@@ -2,6 +2,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "qp_internal.h"
 #include "qp_lvgl.h"
 #include "timer.h"
 #include "deferred_exec.h"
@@ -18,20 +19,104 @@ static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_ta
 
 painter_device_t selected_display = NULL;
 void            *color_buffer     = NULL;
+#ifdef QP_LVGL_DOUBLE_BUFFER
+static void *color_buffer_2 = NULL;
+#endif
+
+// Quantum Painter's RGB565 panels and surfaces expect big-endian pixels, which LVGL only renders with LV_COLOR_16_SWAP
+#if LV_COLOR_DEPTH == 16 && !LV_COLOR_16_SWAP
+#    define QP_LVGL_SWAP_RGB565
+#endif
+
+// Area handed over by LVGL which is still being streamed to the panel
+typedef struct qp_lvgl_transfer_t {
+    lv_disp_drv_t *disp; // NULL when no transfer is in progress
+    lv_area_t      area;
+    lv_color_t    *pixels;
+    lv_coord_t     next_row;
+} qp_lvgl_transfer_t;
+
+static qp_lvgl_transfer_t lvgl_transfer = {0};
+static qp_lvgl_timing_t   lvgl_timing   = {0};
+
+__attribute__((weak)) void qp_lvgl_timing_kb(const qp_lvgl_timing_t *timing) {
+    qp_lvgl_timing_user(timing);
+}
+
+__attribute__((weak)) void qp_lvgl_timing_user(const qp_lvgl_timing_t *timing) {}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_transfer_rows
+
+static void qp_lvgl_transfer_rows(lv_coord_t max_rows) {
+    qp_lvgl_transfer_t *transfer = &lvgl_transfer;
+    if (!transfer->disp) {
+        return;
+    }
+
+    uint32_t   start    = timer_read32();
+    lv_coord_t width    = transfer->area.x2 - transfer->area.x1 + 1;
+    lv_coord_t last_row = transfer->area.y2;
+    if (max_rows > 0 && transfer->next_row + max_rows - 1 < last_row) {
+        last_row = transfer->next_row + max_rows - 1;
+    }
+
+    // LVGL renders each area contiguously, so any band of full rows can be sent straight from its buffer
+    uint32_t          number_pixels = (uint32_t)(last_row - transfer->next_row + 1) * width;
+    const lv_color_t *rows          = &transfer->pixels[(uint32_t)(transfer->next_row - transfer->area.y1) * width];
+    qp_viewport(selected_display, transfer->area.x1, transfer->next_row, transfer->area.x2, last_row);
+    qp_pixdata(selected_display, (const void *)rows, number_pixels);
+    transfer->next_row = last_row + 1;
+
+    bool done = transfer->next_row > transfer->area.y2;
+    if (done) {
+        qp_flush(selected_display);
+    }
+
+    lvgl_timing.transfer_ms += TIMER_DIFF_32(timer_read32(), start);
+    lvgl_timing.pixels += number_pixels;
+
+    if (done) {
+        lv_disp_drv_t *disp = transfer->disp;
+        transfer->disp      = NULL;
+        lv_disp_flush_ready(disp);
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
+        // LVGL can hand over the next area before the previous one has been streamed, e.g. with a full-screen
+        // buffer, finish sending the previous one before it is replaced
+        qp_lvgl_transfer_rows(0);
+
+#ifdef QP_LVGL_SWAP_RGB565
+        // LVGL re-renders the whole buffer before reusing it, so it can be converted in place
         uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
-        qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
-        qp_pixdata(selected_display, (void *)color_p, number_pixels);
-        qp_flush(selected_display);
-        lv_disp_flush_ready(disp);
+        for (uint32_t i = 0; i < number_pixels; ++i) {
+            color_p[i].full = (color_p[i].full << 8) | (color_p[i].full >> 8);
+        }
+#endif
+        lvgl_transfer.area     = *area;
+        lvgl_transfer.pixels   = color_p;
+        lvgl_transfer.next_row = area->y1;
+        lvgl_transfer.disp     = disp;
+#if QP_LVGL_TRANSFER_ROWS == 0
+        qp_lvgl_transfer_rows(0);
+#endif
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_wait
+
+static void qp_lvgl_wait(lv_disp_drv_t *disp) {
+    // LVGL needs the buffer back before it can continue rendering, finish the outstanding transfer
+    qp_lvgl_transfer_rows(0);
+}
+
 static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
     lvgl_state_t   *state     = (lvgl_state_t *)cb_arg;
     static uint32_t last_tick = 0;
@@ -41,9 +126,12 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
             lv_tick_inc(TIMER_DIFF_32(now, last_tick));
             last_tick = now;
         } break;
-        case 1:
+        case 1: {
+            uint32_t start       = timer_read32();
+            uint32_t transfer_ms = lvgl_timing.transfer_ms;
             lv_task_handler();
-            break;
+            lvgl_timing.render_ms += TIMER_DIFF_32(timer_read32(), start) - (lvgl_timing.transfer_ms - transfer_ms);
+        } break;
 
         default:
             break;
@@ -90,13 +178,20 @@ bool qp_lvgl_attach(painter_device_t device) {
         return false;
     }
 
+    // LVGL's buffers are streamed to the panel as-is, so they need to match its native pixel size
+    if (driver->native_bits_per_pixel != sizeof(lv_color_t) * 8) {
+        qp_dprintf("qp_lvgl_attach: fail (LV_COLOR_DEPTH does not match the native format of the display)\n");
+        qp_lvgl_detach();
+        return false;
+    }
+
     // Init LVGL
     lv_init();
 
     // Set up lvgl display buffer
     static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required   = driver->panel_width * driver->panel_height / 10;
+    // Allocate a buffer for 1/QP_LVGL_BUFFER_DIVISOR screen size
+    const size_t count_required   = driver->panel_width * driver->panel_height / QP_LVGL_BUFFER_DIVISOR;
     void        *new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
     if (!new_color_buffer) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
@@ -105,8 +200,22 @@ bool qp_lvgl_attach(painter_device_t device) {
     }
     color_buffer = new_color_buffer;
     memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
+#ifdef QP_LVGL_DOUBLE_BUFFER
+    // Second buffer, so LVGL can render the next area while the previous one is being transferred
+    void *new_color_buffer_2 = realloc(color_buffer_2, sizeof(lv_color_t) * count_required);
+    if (!new_color_buffer_2) {
+        qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
+        qp_lvgl_detach();
+        return false;
+    }
+    color_buffer_2 = new_color_buffer_2;
+    memset(color_buffer_2, 0, sizeof(lv_color_t) * count_required);
+    // Initialize the display buffer.
+    lv_disp_draw_buf_init(&draw_buf, color_buffer, color_buffer_2, count_required);
+#else
     // Initialize the display buffer.
     lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
+#endif
 
     selected_display = device;
 
@@ -117,6 +226,7 @@ bool qp_lvgl_attach(painter_device_t device) {
     static lv_disp_drv_t disp_drv;     /*Descriptor of a display driver*/
     lv_disp_drv_init(&disp_drv);       /*Basic initialization*/
     disp_drv.flush_cb = qp_lvgl_flush; /*Set your driver function*/
+    disp_drv.wait_cb  = qp_lvgl_wait;  /*Finish pending transfers when LVGL needs a buffer back*/
     disp_drv.draw_buf = &draw_buf;     /*Assign the buffer to the display*/
     disp_drv.hor_res  = panel_width;   /*Set the horizontal resolution of the display*/
     disp_drv.ver_res  = panel_height;  /*Set the vertical resolution of the display*/
@@ -136,6 +246,14 @@ void qp_lvgl_detach(void) {
         free(color_buffer);
         color_buffer = NULL;
     }
+#ifdef QP_LVGL_DOUBLE_BUFFER
+    if (color_buffer_2) {
+        free(color_buffer_2);
+        color_buffer_2 = NULL;
+    }
+#endif
+    memset(&lvgl_transfer, 0, sizeof(lvgl_transfer));
+    memset(&lvgl_timing, 0, sizeof(lvgl_timing));
     selected_display = NULL;
 }
 
@@ -145,4 +263,15 @@ void qp_lvgl_detach(void) {
 void qp_lvgl_internal_tick(void) {
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
+
+#if QP_LVGL_TRANSFER_ROWS > 0
+    // Stream a band of the pending area, so long transfers don't stall the matrix scan
+    qp_lvgl_transfer_rows(QP_LVGL_TRANSFER_ROWS);
+#endif
+
+    // Report once everything LVGL rendered has reached the panel
+    if (!lvgl_transfer.disp && lvgl_timing.pixels) {
+        qp_lvgl_timing_kb(&lvgl_timing);
+        memset(&lvgl_timing, 0, sizeof(lvgl_timing));
+    }
 }
@@ -11,6 +11,29 @@
 #    define QP_LVGL_TASK_PERIOD 5
 #endif
 
+// Size of each LVGL draw buffer, as a fraction of the panel area
+#ifndef QP_LVGL_BUFFER_DIVISOR
+#    define QP_LVGL_BUFFER_DIVISOR 10
+#endif
+
+// Rows of a flushed area to stream to the panel per Quantum Painter housekeeping tick, 0 transfers the whole area
+// immediately
+#ifndef QP_LVGL_TRANSFER_ROWS
+#    define QP_LVGL_TRANSFER_ROWS 0
+#endif
+
+// With a single draw buffer LVGL waits for each area to be fully sent before rendering the next part, so streaming
+// needs the second one
+#if QP_LVGL_TRANSFER_ROWS > 0 && !defined(QP_LVGL_DOUBLE_BUFFER)
+#    define QP_LVGL_DOUBLE_BUFFER
+#endif
+
+typedef struct qp_lvgl_timing_t {
+    uint32_t render_ms;   // time spent in the LVGL task handler, excluding transfers
+    uint32_t transfer_ms; // time spent streaming pixel data to the panel
+    uint32_t pixels;      // number of pixels transferred
+} qp_lvgl_timing_t;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
@@ -27,3 +50,11 @@ bool qp_lvgl_attach(painter_device_t device);
  * Disconnects LVGL from any attached display
  */
 void qp_lvgl_detach(void);
+
+/**
+ * Invoked once all flushed areas have been transferred to the panel, with the time taken since the previous report.
+ *
+ * @param timing[in] the render and transfer times, in milliseconds
+ */
+void qp_lvgl_timing_kb(const qp_lvgl_timing_t *timing);
+void qp_lvgl_timing_user(const qp_lvgl_timing_t *timing);
@@ -36,6 +36,16 @@
 #    define QUANTUM_PAINTER_NUM_IMAGES 8
 #endif // QUANTUM_PAINTER_NUM_IMAGES
 
+#ifndef QUANTUM_PAINTER_NUM_PREPARED_IMAGES
+/**
+ * @def This controls the maximum number of prepared images that Quantum Painter can track at any one time. Prepared
+ *      images can be created using \ref qp_prepare_image or \ref qp_load_prepared_image_mem, and can be released by
+ *      calling \ref qp_close_prepared_image. The native pixel data is held in a buffer supplied by the caller, just
+ *      metadata is held by Quantum Painter.
+ */
+#    define QUANTUM_PAINTER_NUM_PREPARED_IMAGES 8
+#endif // QUANTUM_PAINTER_NUM_PREPARED_IMAGES
+
 #ifndef QUANTUM_PAINTER_NUM_FONTS
 /**
  * @def This controls the maximum number of fonts that Quantum Painter can load. Fonts can be loaded using
@@ -117,6 +127,19 @@ typedef struct painter_image_desc_t {
  */
 typedef const painter_image_desc_t *painter_image_handle_t;
 
+/**
+ * @typedef A descriptor for a Quantum Painter prepared image, whose pixels are already in a device's native format.
+ */
+typedef struct painter_prepared_image_desc_t {
+    uint16_t width;  ///< Prepared image width
+    uint16_t height; ///< Prepared image height
+} painter_prepared_image_desc_t;
+
+/**
+ * @typedef A handle to a Quantum Painter prepared image.
+ */
+typedef const painter_prepared_image_desc_t *painter_prepared_image_handle_t;
+
 /**
  * @typedef A descriptor for a Quantum Painter font.
  */
@@ -353,6 +376,21 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads an image stored in external flash.
+ *
+ * @note The image data is streamed from flash as it is drawn, through a small read-ahead cache -- it is never copied
+ *       into RAM in its entirety. Images can be unloaded by calling \ref qp_close_image.
+ *
+ * @param address[in] the offset within external flash at which the image data starts
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -429,6 +467,102 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
  */
 void qp_stop_animation(deferred_token anim_token);
 
+/**
+ * Retrieves the number of bytes required to hold a prepared image of the given size in the device's native format.
+ *
+ * @param device[in] the handle of the device the prepared image will be drawn to
+ * @param width[in] the width of the prepared image
+ * @param height[in] the height of the prepared image
+ * @return the number of bytes required for the buffer supplied to \ref qp_prepare_image
+ */
+uint32_t qp_prepared_image_size(painter_device_t device, uint16_t width, uint16_t height);
+
+/**
+ * Decodes a frame of an image into the device's native pixel format, for later drawing using \ref qp_blit.
+ *
+ * @note Prepared images can be released by calling \ref qp_close_prepared_image. The supplied buffer must remain valid
+ *       until then, and should be 4-byte aligned. Delta frames only update the region they cover, so successive frames
+ *       of an animation can be prepared into the same buffer.
+ *
+ * @param device[in] the handle of the device the prepared image will be drawn to
+ * @param image[in] the handle of the image to prepare
+ * @param frame_number[in] the frame of the image to prepare
+ * @param buffer[in] the buffer to hold the native pixel data, sized using \ref qp_prepared_image_size
+ * @param buffer_size[in] the size of the supplied buffer, in bytes
+ * @return a prepared image handle usable with \ref qp_blit and \ref qp_blit_region
+ * @return NULL if preparing the image failed
+ */
+painter_prepared_image_handle_t qp_prepare_image(painter_device_t device, painter_image_handle_t image, uint16_t frame_number, void *buffer, uint32_t buffer_size);
+
+/**
+ * Decodes a frame of an image into the device's native pixel format, recoloring monochrome images to the desired
+ * foreground/background.
+ *
+ * @param device[in] the handle of the device the prepared image will be drawn to
+ * @param image[in] the handle of the image to prepare
+ * @param frame_number[in] the frame of the image to prepare
+ * @param buffer[in] the buffer to hold the native pixel data, sized using \ref qp_prepared_image_size
+ * @param buffer_size[in] the size of the supplied buffer, in bytes
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return a prepared image handle usable with \ref qp_blit and \ref qp_blit_region
+ * @return NULL if preparing the image failed
+ */
+painter_prepared_image_handle_t qp_prepare_image_recolor(painter_device_t device, painter_image_handle_t image, uint16_t frame_number, void *buffer, uint32_t buffer_size, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Wraps pixel data already in the device's native format (such as an atlas held in flash) as a prepared image.
+ *
+ * @param device[in] the handle of the device the pixel data was generated for
+ * @param width[in] the width of the pixel data
+ * @param height[in] the height of the pixel data
+ * @param buffer[in] the native pixel data, laid out row by row
+ * @return a prepared image handle usable with \ref qp_blit and \ref qp_blit_region
+ * @return NULL if loading the prepared image failed
+ */
+painter_prepared_image_handle_t qp_load_prepared_image_mem(painter_device_t device, uint16_t width, uint16_t height, const void *buffer);
+
+/**
+ * Closes a prepared image handle when no longer in use.
+ *
+ * @param prepared[in] the handle of the prepared image to release
+ * @return true if releasing the prepared image succeeded
+ * @return false if releasing the prepared image failed
+ */
+bool qp_close_prepared_image(painter_prepared_image_handle_t prepared);
+
+/**
+ * Draws a prepared image to the display, without any further decoding or pixel conversion.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x[in] the x-position where the prepared image should be drawn onto the device
+ * @param y[in] the y-position where the prepared image should be drawn onto the device
+ * @param prepared[in] the handle of the prepared image to draw
+ * @return true if drawing the prepared image succeeded
+ * @return false if drawing the prepared image failed
+ */
+bool qp_blit(painter_device_t device, uint16_t x, uint16_t y, painter_prepared_image_handle_t prepared);
+
+/**
+ * Draws a rectangular region of a prepared image to the display, such as a single sprite out of an atlas.
+ *
+ * @param device[in] the handle of the device to control
+ * @param x[in] the x-position where the region should be drawn onto the device
+ * @param y[in] the y-position where the region should be drawn onto the device
+ * @param prepared[in] the handle of the prepared image to draw from
+ * @param left[in] the prepared image's x-position to start
+ * @param top[in] the prepared image's y-position to start
+ * @param right[in] the prepared image's x-position to finish
+ * @param bottom[in] the prepared image's y-position to finish
+ * @return true if drawing the region succeeded
+ * @return false if drawing the region failed
+ */
+bool qp_blit_region(painter_device_t device, uint16_t x, uint16_t y, painter_prepared_image_handle_t prepared, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+
 /**
  * Loads a font into memory.
  *
@@ -440,6 +574,20 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads a font stored in external flash.
+ *
+ * @note The font data is streamed from flash as it is drawn, through a small read-ahead cache, unless
+ *       QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is enabled. Fonts can be unloaded by calling \ref qp_close_font.
+ *
+ * @param address[in] the offset within external flash at which the font data starts
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
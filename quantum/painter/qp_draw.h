@@ -27,6 +27,22 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// Span rasterizer -- collects adjacent pixels on the same row or column, emitting each run as a single viewport+pixdata
+// transfer. Uses the global pixdata buffer with pre-converted native pixels, which needs to hold at least as many pixels
+// as the longest run (capped at the buffer size).
+typedef struct qp_internal_span_t {
+    painter_device_t device;
+    int16_t          x0;
+    int16_t          y0;
+    int16_t          x1;
+    int16_t          y1;
+    bool             active;
+} qp_internal_span_t;
+
+void qp_internal_span_init(qp_internal_span_t* span, painter_device_t device);
+bool qp_internal_span_add(qp_internal_span_t* span, int16_t x, int16_t y);
+bool qp_internal_span_flush(qp_internal_span_t* span);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
 typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
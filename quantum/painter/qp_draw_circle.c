@@ -7,115 +7,49 @@
 #include "qp_comms.h"
 #include "qp_draw.h"
 
-// Utilize 8-way symmetry to draw circles
-static bool qp_circle_helper_impl(painter_device_t device, uint16_t centerx, uint16_t centery, uint16_t offsetx, uint16_t offsety, bool filled) {
+// Utilize 8-way symmetry to draw circle outlines
+static bool qp_circle_outline_helper_impl(qp_internal_span_t *spans, int16_t centerx, int16_t centery, int16_t offsetx, int16_t offsety) {
     /*
     Circles have the property of 8-way symmetry, so eight pixels can be drawn
     for each computed [offsetx,offsety] given the center coordinates
     represented by [centerx,centery].
 
-    For filled circles, we can draw horizontal lines between each pair of
-    pixels with the same final value of y.
-
-    Two special cases exist and have been optimized:
-    1) offsetx == offsety (the final point), makes half the coordinates
-    equivalent, so we can omit them (and the corresponding fill lines)
-    2) offsetx == 0 (the starting point) means that some horizontal lines
-    would be a single pixel in length, so we write individual pixels instead.
-    This also makes half the symmetrical points identical to their twins,
-    so we only need four points or two points and one line
+    Each octant gets its own span, as successive pixels within an octant are
+    generally adjacent along a row (near the top and bottom) or a column (near
+    the left and right). Those runs are then sent as single transfers instead
+    of one pixel at a time.
     */
 
-    int16_t xpx = ((int16_t)centerx) + ((int16_t)offsetx);
-    int16_t xmx = ((int16_t)centerx) - ((int16_t)offsetx);
-    int16_t xpy = ((int16_t)centerx) + ((int16_t)offsety);
-    int16_t xmy = ((int16_t)centerx) - ((int16_t)offsety);
-    int16_t ypx = ((int16_t)centery) + ((int16_t)offsetx);
-    int16_t ymx = ((int16_t)centery) - ((int16_t)offsetx);
-    int16_t ypy = ((int16_t)centery) + ((int16_t)offsety);
-    int16_t ymy = ((int16_t)centery) - ((int16_t)offsety);
-
-    if (offsetx == 0) {
-        if (!qp_internal_setpixel_impl(device, centerx, ypy)) {
-            return false;
-        }
-        if (!qp_internal_setpixel_impl(device, centerx, ymy)) {
-            return false;
-        }
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, centery, xmy, centery)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, centery)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, centery)) {
-                return false;
-            }
-        }
-    } else if (offsetx == offsety) {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypy, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymy, xmy, ymy)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymy)) {
-                return false;
-            }
-        }
+    return qp_internal_span_add(&spans[0], centerx + offsetx, centery + offsety)    // bottom, right of centre
+           && qp_internal_span_add(&spans[1], centerx - offsetx, centery + offsety) // bottom, left of centre
+           && qp_internal_span_add(&spans[2], centerx + offsetx, centery - offsety) // top, right of centre
+           && qp_internal_span_add(&spans[3], centerx - offsetx, centery - offsety) // top, left of centre
+           && qp_internal_span_add(&spans[4], centerx + offsety, centery + offsetx) // right, below centre
+           && qp_internal_span_add(&spans[5], centerx - offsety, centery + offsetx) // left, below centre
+           && qp_internal_span_add(&spans[6], centerx + offsety, centery - offsetx) // right, above centre
+           && qp_internal_span_add(&spans[7], centerx - offsety, centery - offsetx); // left, above centre
+}
 
-    } else {
-        if (filled) {
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ypy, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpx, ymy, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ypx, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_fillrect_helper_impl(device, xpy, ymx, xmy, ymx)) {
-                return false;
-            }
-        } else {
-            if (!qp_internal_setpixel_impl(device, xpx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ypy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmx, ymy)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ypx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xpy, ymx)) {
-                return false;
-            }
-            if (!qp_internal_setpixel_impl(device, xmy, ymx)) {
-                return false;
-            }
+// Draws the pair of rows at [centery +/- offsety], each spanning [centerx +/- halfwidth]
+static bool qp_circle_fill_helper_impl(painter_device_t device, int16_t centerx, int16_t centery, int16_t halfwidth, int16_t offsety) {
+    qp_internal_span_t span;
+    qp_internal_span_init(&span, device);
+
+    span.x0     = centerx - halfwidth;
+    span.x1     = centerx + halfwidth;
+    span.y0     = centery + offsety;
+    span.y1     = centery + offsety;
+    span.active = true;
+    if (!qp_internal_span_flush(&span)) {
+        return false;
+    }
+
+    if (offsety != 0) {
+        span.y0     = centery - offsety;
+        span.y1     = centery - offsety;
+        span.active = true;
+        if (!qp_internal_span_flush(&span)) {
+            return false;
         }
     }
 
@@ -146,23 +80,49 @@ bool qp_circle(painter_device_t device, uint16_t x, uint16_t y, uint16_t radius,
     }
 
     bool ret = true;
-    if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
-        ret = false;
-    }
-
-    if (ret) {
-        while (xcalc < ycalc) {
+    if (filled) {
+        /*
+        For filled circles, the rows at [y +/- xcalc] are unique for each step
+        and span [x +/- ycalc]. The rows at [y +/- ycalc] repeat while ycalc is
+        unchanged, so they're only drawn once at their widest -- just before
+        ycalc changes, or at the end.
+        */
+        ret = qp_circle_fill_helper_impl(device, x, y, ycalc, xcalc);
+        while (ret && xcalc < ycalc) {
             xcalc++;
             if (err < 0) {
                 err += (xcalc << 1) + 1;
             } else {
+                ret = qp_circle_fill_helper_impl(device, x, y, xcalc - 1, ycalc);
                 ycalc--;
                 err += ((xcalc - ycalc) << 1) + 1;
             }
-            if (!qp_circle_helper_impl(device, x, y, xcalc, ycalc, filled)) {
-                ret = false;
-                break;
+            ret = ret && qp_circle_fill_helper_impl(device, x, y, ycalc, xcalc);
+        }
+        if (ret && xcalc != ycalc) {
+            ret = qp_circle_fill_helper_impl(device, x, y, xcalc, ycalc);
+        }
+    } else {
+        qp_internal_span_t spans[8];
+        for (int i = 0; i < 8; ++i) {
+            qp_internal_span_init(&spans[i], device);
+        }
+
+        ret = qp_circle_outline_helper_impl(spans, x, y, xcalc, ycalc);
+        while (ret && xcalc < ycalc) {
+            xcalc++;
+            if (err < 0) {
+                err += (xcalc << 1) + 1;
+            } else {
+                ycalc--;
+                err += ((xcalc - ycalc) << 1) + 1;
             }
+            ret = qp_circle_outline_helper_impl(spans, x, y, xcalc, ycalc);
+        }
+
+        // Send any remaining runs
+        for (int i = 0; ret && i < 8; ++i) {
+            ret = qp_internal_span_flush(&spans[i]);
         }
     }
 
@@ -141,6 +141,69 @@ bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Span rasterizer
+
+void qp_internal_span_init(qp_internal_span_t *span, painter_device_t device) {
+    span->device = device;
+    span->active = false;
+}
+
+bool qp_internal_span_flush(qp_internal_span_t *span) {
+    if (!span->active) {
+        return true;
+    }
+    span->active = false;
+
+    // Drop anything that's entirely off the top/left of the display, and clip anything that straddles it
+    if (span->x1 < 0 || span->y1 < 0) {
+        return true;
+    }
+    return qp_internal_fillrect_helper_impl(span->device, MAX(span->x0, 0), MAX(span->y0, 0), span->x1, span->y1);
+}
+
+bool qp_internal_span_add(qp_internal_span_t *span, int16_t x, int16_t y) {
+    if (span->active) {
+        // Horizontal run (or a single pixel, which can grow in either direction)
+        if (span->y0 == y && span->y1 == y) {
+            if (x >= span->x0 && x <= span->x1) {
+                return true;
+            } else if (x == span->x1 + 1) {
+                span->x1 = x;
+                return true;
+            } else if (x == span->x0 - 1) {
+                span->x0 = x;
+                return true;
+            }
+        }
+
+        // Vertical run
+        if (span->x0 == x && span->x1 == x) {
+            if (y >= span->y0 && y <= span->y1) {
+                return true;
+            } else if (y == span->y1 + 1) {
+                span->y1 = y;
+                return true;
+            } else if (y == span->y0 - 1) {
+                span->y0 = y;
+                return true;
+            }
+        }
+
+        // Not adjacent, so send what we've got so far
+        if (!qp_internal_span_flush(span)) {
+            return false;
+        }
+    }
+
+    span->x0     = x;
+    span->y0     = y;
+    span->x1     = x;
+    span->y1     = y;
+    span->active = true;
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_setpixel
 
@@ -186,8 +249,6 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
         return false;
     }
 
-    qp_internal_fill_pixdata(device, 1, hue, sat, val);
-
     // draw angled line using Bresenham's algo
     int16_t x      = ((int16_t)x0);
     int16_t y      = ((int16_t)y0);
@@ -199,9 +260,15 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
     int16_t e  = dx + dy;
     int16_t e2 = 2 * e;
 
+    // Runs of pixels along the major axis are sent as a single transfer, so prepare enough pixels for the longest run
+    qp_internal_fill_pixdata(device, MAX(dx, -dy) + 1, hue, sat, val);
+
+    qp_internal_span_t span;
+    qp_internal_span_init(&span, device);
+
     bool ret = true;
     while (x != x1 || y != y1) {
-        if (!qp_internal_setpixel_impl(device, x, y)) {
+        if (!qp_internal_span_add(&span, x, y)) {
             ret = false;
             break;
         }
@@ -215,8 +282,8 @@ bool qp_line(painter_device_t device, uint16_t x0, uint16_t y0, uint16_t x1, uin
             y += slopey;
         }
     }
-    // draw the last pixel
-    if (!qp_internal_setpixel_impl(device, x, y)) {
+    // draw the last pixel, and send the final run
+    if (!ret || !qp_internal_span_add(&span, x, y) || !qp_internal_span_flush(&span)) {
         ret = false;
     }
 
@@ -283,8 +350,10 @@ bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t righ
         // Fill up the pixdata buffer with the required number of native pixels
         qp_internal_fill_pixdata(device, MAX(w, h), hue, sat, val);
 
-        // Draw 4x filled single-width rects to create an outline
-        if (!qp_internal_fillrect_helper_impl(device, l, t, r, t) || !qp_internal_fillrect_helper_impl(device, l, b, r, b) || !qp_internal_fillrect_helper_impl(device, l, t + 1, l, b - 1) || !qp_internal_fillrect_helper_impl(device, r, t + 1, r, b - 1)) {
+        // Draw 4x filled single-width rects to create an outline, skipping any that would overlap for thin rects
+        if (!qp_internal_fillrect_helper_impl(device, l, t, r, t) || (b > t && !qp_internal_fillrect_helper_impl(device, l, b, r, b))) {
+            ret = false;
+        } else if (h > 2 && (!qp_internal_fillrect_helper_impl(device, l, t + 1, l, b - 1) || (r > l && !qp_internal_fillrect_helper_impl(device, r, t + 1, r, b - 1)))) {
             ret = false;
         }
     }
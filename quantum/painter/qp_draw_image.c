@@ -19,6 +19,9 @@ typedef struct qgf_image_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef FLASH_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // FLASH_ENABLE
     };
 } qgf_image_handle_t;
 
@@ -85,6 +88,30 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef FLASH_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the graphics descriptor
+    image->flash_stream = qp_make_flash_stream(address, sizeof(qgf_graphics_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    image->flash_stream.length   = qgf_get_total_size(&image->stream);
+    image->flash_stream.position = 0;
+
+    return image->flash_stream.length > 0;
+}
+
+painter_image_handle_t qp_load_image_flash(uint32_t address) {
+    return qp_load_image_internal(image_flash_stream_factory, &address);
+}
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -387,6 +414,315 @@ void qp_stop_animation(deferred_token anim_token) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Prepared image handles
+
+typedef struct prepared_image_handle_t {
+    painter_prepared_image_desc_t base;
+    bool                          validate_ok;
+    uint8_t                       bits_per_pixel;
+    const uint8_t                *pixels;
+} prepared_image_handle_t;
+
+static prepared_image_handle_t prepared_descriptors[QUANTUM_PAINTER_NUM_PREPARED_IMAGES] = {0};
+
+static prepared_image_handle_t *qp_prepared_image_allocate(painter_driver_t *driver, uint16_t width, uint16_t height, const void *buffer) {
+    for (int i = 0; i < QUANTUM_PAINTER_NUM_PREPARED_IMAGES; ++i) {
+        if (!prepared_descriptors[i].validate_ok) {
+            prepared_image_handle_t *prepared = &prepared_descriptors[i];
+            prepared->base.width              = width;
+            prepared->base.height             = height;
+            prepared->bits_per_pixel          = driver->native_bits_per_pixel;
+            prepared->pixels                  = (const uint8_t *)buffer;
+            prepared->validate_ok             = true;
+            return prepared;
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_prepared_image_size
+
+uint32_t qp_prepared_image_size(painter_device_t device, uint16_t width, uint16_t height) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver) {
+        return 0;
+    }
+    return (((uint32_t)width) * height * driver->native_bits_per_pixel + 7) / 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_prepare_image_recolor
+
+typedef struct qp_prepared_output_state_t {
+    painter_device_t device;
+    uint8_t         *target_buffer;
+    uint16_t         stride;
+    uint16_t         left;
+    uint16_t         right;
+    uint16_t         x;
+    uint16_t         y;
+    uint8_t          bytes_per_pixel;
+    uint8_t          byte_in_pixel;
+} qp_prepared_output_state_t;
+
+static inline void qp_prepared_advance(qp_prepared_output_state_t *state) {
+    if (++state->x > state->right) {
+        state->x = state->left;
+        ++state->y;
+    }
+}
+
+static bool qp_prepared_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_prepared_output_state_t *state  = (qp_prepared_output_state_t *)cb_arg;
+    painter_driver_t           *driver = (painter_driver_t *)state->device;
+    uint32_t                    offset = ((uint32_t)state->y) * state->stride + state->x;
+    qp_prepared_advance(state);
+    return driver->driver_vtable->append_pixels(state->device, state->target_buffer, palette, offset, 1, &index);
+}
+
+static bool qp_prepared_byte_appender(uint8_t byteval, void *cb_arg) {
+    qp_prepared_output_state_t *state  = (qp_prepared_output_state_t *)cb_arg;
+    painter_driver_t           *driver = (painter_driver_t *)state->device;
+    uint32_t                    offset = (((uint32_t)state->y) * state->stride + state->x) * state->bytes_per_pixel + state->byte_in_pixel;
+    if (++state->byte_in_pixel == state->bytes_per_pixel) {
+        state->byte_in_pixel = 0;
+        qp_prepared_advance(state);
+    }
+    return driver->driver_vtable->append_pixdata(state->device, state->target_buffer, offset, byteval);
+}
+
+static painter_prepared_image_handle_t qp_prepare_image_recolor_impl(painter_device_t device, painter_image_handle_t image, uint16_t frame_number, void *buffer, uint32_t buffer_size, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_dprintf("qp_prepare_image_recolor: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_prepare_image_recolor: fail (validation_ok == false)\n");
+        return NULL;
+    }
+
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok || frame_number >= image->frame_count) {
+        qp_dprintf("qp_prepare_image_recolor: fail (invalid image)\n");
+        return NULL;
+    }
+
+    if (!buffer || buffer_size < qp_prepared_image_size(device, image->width, image->height)) {
+        qp_dprintf("qp_prepare_image_recolor: fail (buffer too small)\n");
+        return NULL;
+    }
+
+    // Read the frame info, converting the palette to native format as we go
+    qgf_frame_info_t frame_info = {0};
+    if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, &frame_info)) {
+        qp_dprintf("qp_prepare_image_recolor: fail (could not read frame %d)\n", (int)frame_number);
+        return NULL;
+    }
+
+    // Work out which region of the prepared image this frame covers
+    uint16_t l, t, r, b;
+    if (frame_info.is_delta) {
+        l = frame_info.left;
+        t = frame_info.top;
+        r = frame_info.right;
+        b = frame_info.bottom;
+    } else {
+        l = 0;
+        t = 0;
+        r = image->width - 1;
+        b = image->height - 1;
+    }
+    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
+
+    qp_prepared_output_state_t output_state = {.device = device, .target_buffer = (uint8_t *)buffer, .stride = image->width, .left = l, .right = r, .x = l, .y = t};
+
+    // Set up the input state
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info.compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_prepare_image_recolor: fail (invalid image compression scheme)\n");
+        return NULL;
+    }
+
+    // Decode the pixels straight into the target buffer, in the native format
+    bool ret = false;
+    if (frame_info.bpp <= 8) {
+        ret = qp_internal_decode_palette(device, pixel_count, frame_info.bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_prepared_pixel_appender, &output_state);
+    } else if (frame_info.bpp != driver->native_bits_per_pixel || (frame_info.bpp % 8) != 0) {
+        qp_dprintf("qp_prepare_image_recolor: fail (asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d))\n", (int)frame_info.bpp, (int)driver->native_bits_per_pixel);
+    } else {
+        output_state.bytes_per_pixel = frame_info.bpp / 8;
+        ret                          = qp_internal_send_bytes(device, pixel_count * output_state.bytes_per_pixel, input_callback, &input_state, qp_prepared_byte_appender, &output_state);
+    }
+
+    if (!ret) {
+        qp_dprintf("qp_prepare_image_recolor: fail (could not decode pixels)\n");
+        return NULL;
+    }
+
+    // If the buffer is already in use by a prepared image for this device (i.e. successive animation frames), reuse the handle
+    for (int i = 0; i < QUANTUM_PAINTER_NUM_PREPARED_IMAGES; ++i) {
+        prepared_image_handle_t *prepared = &prepared_descriptors[i];
+        if (prepared->validate_ok && prepared->pixels == buffer && prepared->base.width == image->width && prepared->base.height == image->height && prepared->bits_per_pixel == driver->native_bits_per_pixel) {
+            qp_dprintf("qp_prepare_image_recolor: ok (reused handle)\n");
+            return (painter_prepared_image_handle_t)prepared;
+        }
+    }
+
+    prepared_image_handle_t *prepared = qp_prepared_image_allocate(driver, image->width, image->height, buffer);
+    qp_dprintf("qp_prepare_image_recolor: %s\n", prepared ? "ok" : "fail (no free slot)");
+    return (painter_prepared_image_handle_t)prepared;
+}
+
+painter_prepared_image_handle_t qp_prepare_image_recolor(painter_device_t device, painter_image_handle_t image, uint16_t frame_number, void *buffer, uint32_t buffer_size, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    return qp_prepare_image_recolor_impl(device, image, frame_number, buffer, buffer_size, fg_hsv888, bg_hsv888);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_prepare_image
+
+painter_prepared_image_handle_t qp_prepare_image(painter_device_t device, painter_image_handle_t image, uint16_t frame_number, void *buffer, uint32_t buffer_size) {
+    return qp_prepare_image_recolor(device, image, frame_number, buffer, buffer_size, 0, 0, 255, 0, 0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_prepared_image_mem
+
+painter_prepared_image_handle_t qp_load_prepared_image_mem(painter_device_t device, uint16_t width, uint16_t height, const void *buffer) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !buffer || width == 0 || height == 0) {
+        qp_dprintf("qp_load_prepared_image_mem: fail (invalid arguments)\n");
+        return NULL;
+    }
+
+    prepared_image_handle_t *prepared = qp_prepared_image_allocate(driver, width, height, buffer);
+    qp_dprintf("qp_load_prepared_image_mem: %s\n", prepared ? "ok" : "fail (no free slot)");
+    return (painter_prepared_image_handle_t)prepared;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_close_prepared_image
+
+bool qp_close_prepared_image(painter_prepared_image_handle_t prepared) {
+    prepared_image_handle_t *handle = (prepared_image_handle_t *)prepared;
+    if (!handle || !handle->validate_ok) {
+        qp_dprintf("qp_close_prepared_image: fail (invalid prepared image)\n");
+        return false;
+    }
+
+    // Free up this slot for use elsewhere -- the pixel buffer is owned by the caller.
+    handle->validate_ok = false;
+    handle->pixels      = NULL;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_blit_region
+
+// Copies a run of bits (i.e. sub-byte native pixels) from the source to the destination, LSB-first as per the surfaces
+static void qp_blit_copy_bits(uint8_t *dst, uint32_t dst_bit, const uint8_t *src, uint32_t src_bit, uint32_t bit_count) {
+    for (uint32_t i = 0; i < bit_count; ++i, ++dst_bit, ++src_bit) {
+        if (src[src_bit / 8] & (1 << (src_bit % 8))) {
+            dst[dst_bit / 8] |= (1 << (dst_bit % 8));
+        } else {
+            dst[dst_bit / 8] &= ~(1 << (dst_bit % 8));
+        }
+    }
+}
+
+bool qp_blit_region(painter_device_t device, uint16_t x, uint16_t y, painter_prepared_image_handle_t prepared, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    qp_dprintf("qp_blit_region: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_blit_region: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    prepared_image_handle_t *handle = (prepared_image_handle_t *)prepared;
+    if (!handle || !handle->validate_ok) {
+        qp_dprintf("qp_blit_region: fail (invalid prepared image)\n");
+        return false;
+    }
+
+    if (handle->bits_per_pixel != driver->native_bits_per_pixel) {
+        qp_dprintf("qp_blit_region: fail (prepared image bpp (%d) doesn't match the target display's native_bits_per_pixel (%d))\n", (int)handle->bits_per_pixel, (int)driver->native_bits_per_pixel);
+        return false;
+    }
+
+    // Cater for cases where people have submitted the coordinates backwards, and clip to the prepared image
+    uint16_t l = MIN(left, right);
+    uint16_t r = MIN(MAX(left, right), handle->base.width - 1);
+    uint16_t t = MIN(top, bottom);
+    uint16_t b = MIN(MAX(top, bottom), handle->base.height - 1);
+    if (l > r || t > b) {
+        qp_dprintf("qp_blit_region: fail (region outside prepared image)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_blit_region: fail (could not start comms)\n");
+        return false;
+    }
+
+    const uint8_t  bpp    = handle->bits_per_pixel;
+    const uint16_t w      = r - l + 1;
+    const uint16_t h      = b - t + 1;
+    const uint16_t stride = handle->base.width;
+
+    bool ret = driver->driver_vtable->viewport(device, x, y, x + w - 1, y + h - 1);
+    if (!ret) {
+        qp_dprintf("qp_blit_region: fail (could not set viewport)\n");
+    } else if (w == stride && ((((uint32_t)t) * stride * bpp) % 8) == 0) {
+        // Full-width regions are contiguous in the prepared buffer, so stream them directly without any copying
+        ret = driver->driver_vtable->pixdata(device, handle->pixels + (((uint32_t)t) * stride * bpp) / 8, ((uint32_t)w) * h);
+    } else {
+        // Sub-regions are copied row by row into the pixdata buffer, flushing whenever it fills
+        uint32_t max_pixels   = qp_internal_num_pixels_in_buffer(device);
+        uint32_t buffered     = 0;
+        bool     byte_aligned = (bpp % 8) == 0;
+        for (uint16_t row = t; ret && row <= b; ++row) {
+            uint32_t src_pixel = ((uint32_t)row) * stride + l;
+            uint16_t row_left  = w;
+            while (ret && row_left > 0) {
+                uint32_t copy = MIN(row_left, max_pixels - buffered);
+                if (byte_aligned) {
+                    memcpy(&qp_internal_global_pixdata_buffer[(buffered * bpp) / 8], &handle->pixels[(src_pixel * bpp) / 8], (copy * bpp) / 8);
+                } else {
+                    qp_blit_copy_bits(qp_internal_global_pixdata_buffer, buffered * bpp, handle->pixels, src_pixel * bpp, copy * bpp);
+                }
+                buffered += copy;
+                src_pixel += copy;
+                row_left -= copy;
+                if (buffered == max_pixels) {
+                    ret      = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, buffered);
+                    buffered = 0;
+                }
+            }
+        }
+        // Any leftovers need transmission as well.
+        if (ret && buffered > 0) {
+            ret = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, buffered);
+        }
+    }
+
+    qp_dprintf("qp_blit_region: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_blit
+
+bool qp_blit(painter_device_t device, uint16_t x, uint16_t y, painter_prepared_image_handle_t prepared) {
+    if (!prepared) {
+        qp_dprintf("qp_blit: fail (invalid prepared image)\n");
+        return false;
+    }
+    return qp_blit_region(device, x, y, prepared, 0, 0, prepared->width - 1, prepared->height - 1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Core API: qp_internal_animation_tick
 
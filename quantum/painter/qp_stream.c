@@ -164,3 +164,117 @@ qp_file_stream_t qp_make_file_stream(FILE *f) {
     return stream;
 }
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+#    ifdef FLASH_DRIVER_SPI
+#        include "flash_spi.h"
+STATIC_ASSERT((EXTERNAL_FLASH_PAGE_SIZE % QP_FLASH_STREAM_CACHE_SIZE) == 0, "QP_FLASH_STREAM_CACHE_SIZE must evenly divide EXTERNAL_FLASH_PAGE_SIZE");
+#    endif // FLASH_DRIVER_SPI
+
+// Flash is read-only, so whatever was last read ahead stays valid for any stream that covers the same addresses
+static uint8_t  flash_cache[QP_FLASH_STREAM_CACHE_SIZE];
+static uint32_t flash_cache_address = 0;
+static uint16_t flash_cache_length  = 0;
+
+static bool flash_fill_cache(qp_flash_stream_t *s) {
+    // Start the read on a cache-sized boundary of the flash itself, so that it stays within a single page
+    uint32_t address = s->address + s->position;
+    uint32_t aligned = address - (address % QP_FLASH_STREAM_CACHE_SIZE);
+
+    // ...but never outside of the stream itself
+    uint32_t start = MAX(aligned, s->address);
+    uint32_t end   = MIN(aligned + QP_FLASH_STREAM_CACHE_SIZE, s->address + s->length);
+
+    if (flash_read_range(start, flash_cache, end - start) != FLASH_STATUS_SUCCESS) {
+        flash_cache_length = 0;
+        return false;
+    }
+
+    flash_cache_address = start;
+    flash_cache_length  = end - start;
+    return true;
+}
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+    uint32_t address = s->address + s->position;
+    if (address < flash_cache_address || address >= flash_cache_address + flash_cache_length) {
+        if (!flash_fill_cache(s)) {
+            s->is_eof = true;
+            return STREAM_EOF;
+        }
+    }
+    s->position++;
+    return flash_cache[address - flash_cache_address];
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Assets in external flash are read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds as memory streams -- the cache is left alone, as it's still valid for the new position if it's close
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    // The asset may have been rewritten since the last read
+    flash_cache_length = 0;
+
+    qp_flash_stream_t stream = {
+        .base     = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .address  = address,
+        .length   = length,
+        .position = 0,
+    };
+    return stream;
+}
+
+#endif // FLASH_ENABLE
@@ -83,3 +83,31 @@ typedef struct qp_file_stream_t {
 qp_file_stream_t qp_make_file_stream(FILE *f);
 
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+#    include "flash.h"
+
+#    ifndef QP_FLASH_STREAM_CACHE_SIZE
+/**
+ * @def The number of bytes read ahead from external flash at a time. Reads are aligned to this size, which must evenly
+ *      divide the flash page size so that a read never crosses a page boundary. The read-ahead buffer is shared by all
+ *      flash streams, rather than held by each one.
+ */
+#        define QP_FLASH_STREAM_CACHE_SIZE 64
+#    endif // QP_FLASH_STREAM_CACHE_SIZE
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t base;
+    uint32_t    address;
+    int32_t     length;
+    int32_t     position;
+    bool        is_eof;
+} qp_flash_stream_t;
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length);
+
+#endif // FLASH_ENABLE
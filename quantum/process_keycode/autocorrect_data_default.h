@@ -74,12 +74,8 @@
 
 #define AUTOCORRECT_MIN_LENGTH 5  // ":ture"
 #define AUTOCORRECT_MAX_LENGTH 10 // "accomodate"
+#define AUTOCORRECT_LINK_SIZE 2
 
-#define DICTIONARY_SIZE 1104
+#define DICTIONARY_SIZE 1683
 
-static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {108, 43,  0,   6,   71, 0,  7,   81, 0,   8,   199, 0,   9,   240, 1,  10,  250, 1,  11,  26,  2,   17,  53,  2,   18, 190, 2,   19,  202, 2,   21,  212, 2,   22,  20,  3,   23,  67,  3,   28,  16,  4,   0,  72,  50,  0,   22,  60,  0,   0,   11,  23,  44, 8,   11, 23,  44,  0,   132, 0,   8,   22,  18,  18,  15,  0,  132, 115, 101, 115, 0,   11,  23,  12,  26,  22,  0,   129, 99,  104, 0,   68,  94,  0,   8,   106, 0,   15, 174, 0,   21, 187, 0,   0,   12,  15,  25,  17,  12,  0,   131, 97,  108, 105, 100, 0,   74,  119, 0,   12,  129, 0,   21,  140, 0,   24,  165, 0,   0,   17,  12,  22,  0,   131, 103, 110, 101, 100, 0,   25,  21, 8,   7,   0,   131, 105, 118, 101, 100, 0,   72,  147, 0,  24,  156, 0,  0,   9,   8,   21,  0,   129, 114, 101, 100, 0,   6,   6,   18,  0,   129, 114, 101, 100, 0,   15,  6,   17,  12,  0,   129, 100, 101, 0,   18, 22,  8,   21,  11,  23,  0,   130, 104, 111,
-                                                                  108, 100, 0,   4,   26, 18, 9,   0,  131, 114, 119, 97,  114, 100, 0,  68,  233, 0,  6,   246, 0,   7,   4,   1,   8,  16,  1,   10,  52,  1,   15,  81,  1,   21,  90,  1,   22,  117, 1,   23,  144, 1,   24, 215, 1,   25,  228, 1,   0,   6,   19,  22,  8,  16,  4,  17,  0,   130, 97,  99,  101, 0,   19,  4,   22,  8,  16,  4,   17,  0,   131, 112, 97,  99,  101, 0,   12,  21,  8,   25,  18,  0,   130, 114, 105, 100, 101, 0,  23,  0,   68, 25,  1,   17,  36,  1,   0,   21,  4,   24,  10,  0,   130, 110, 116, 101, 101, 0,   4,   21,  24,  4,   10,  0,   135, 117, 97,  114, 97,  110, 116, 101, 101, 0,   68,  59,  1,   7,   69,  1,   0,  24,  10,  44,  0,   131, 97,  117, 103, 101, 0,   8,   15, 12,  25,  12, 21,  19,  0,   130, 103, 101, 0,   22,  4,   9,   0,   130, 108, 115, 101, 0,   76,  97,  1,   24,  109, 1,   0,   24,  20,  4,   0,   132, 99, 113, 117, 105, 114, 101, 0,   23,  44,  0,
-                                                                  130, 114, 117, 101, 0,  4,  0,   79, 126, 1,   24,  134, 1,   0,   9,  0,   131, 97, 108, 115, 101, 0,   6,   8,   5,  0,   131, 97,  117, 115, 101, 0,   4,   0,   71,  156, 1,   19,  193, 1,   21,  203, 1,  0,   18,  16,  0,   80,  166, 1,   18,  181, 1,  0,   18, 6,   4,   0,   135, 99,  111, 109, 109, 111, 100, 97, 116, 101, 0,   6,   6,   4,   0,   132, 109, 111, 100, 97,  116, 101, 0,   7,   24,  0,   132, 112, 100, 97, 116, 101, 0,  8,   19,  8,   22,  0,   132, 97,  114, 97,  116, 101, 0,   10,  8,   15,  15,  18,  6,   0,   130, 97,  103, 117, 101, 0,   8,   12,  6,   8,   21,  0,   131, 101, 105, 118, 101, 0,   12,  8,   11, 6,   0,   130, 105, 101, 102, 0,   17,  0,   76,  3,   2,  21,  16,  2,  0,   15,  8,   12,  6,   0,   133, 101, 105, 108, 105, 110, 103, 0,   12,  23,  22,  0,   131, 114, 105, 110, 103, 0,   70,  33,  2,   23,  44, 2,   0,   12,  23,  26,  22,  0,   131, 105,
-                                                                  116, 99,  104, 0,   10, 12, 8,   11, 0,   129, 104, 116, 0,   72,  69, 2,   10,  80, 2,   18,  89,  2,   21,  156, 2,  24,  167, 2,   0,   22,  18,  18,  11,  6,   0,   131, 115, 101, 110, 0,   12,  21,  23, 22,  0,   129, 110, 103, 0,   12,  0,   86,  98, 2,   23, 124, 2,   0,   68,  105, 2,   22,  114, 2,   0,   12, 15,  0,   131, 105, 115, 111, 110, 0,   4,   6,   6,   18,  0,   131, 105, 111, 110, 0,   76,  131, 2,   22, 146, 2,   0,  23,  12,  19,  8,   21,  0,   134, 101, 116, 105, 116, 105, 111, 110, 0,   18,  19,  0,   131, 105, 116, 105, 111, 110, 0,   23,  24,  8,   21,  0,   131, 116, 117, 114, 110, 0,   85,  174, 2,   23, 183, 2,   0,   23,  8,   21,  0,   130, 117, 114, 110, 0,  8,   21,  0,  128, 114, 110, 0,   7,   8,   24,  22,  19,  0,   131, 101, 117, 100, 111, 0,   24,  18,  18,  15,  0,   129, 107, 117, 112, 0,   72,  219, 2,  18,  3,   3,   0,   76,  229, 2,   15,  238,
-                                                                  2,   17,  248, 2,   0,  11, 23,  44, 0,   130, 101, 105, 114, 0,   23, 12,  9,   0,  131, 108, 116, 101, 114, 0,   23, 22,  12,  15,  0,   130, 101, 110, 101, 114, 0,   23,  4,   21,  8,   23,  17,  12,  0,  135, 116, 101, 114, 97,  116, 111, 114, 0,   72, 30,  3,  17,  38,  3,   24,  51,  3,   0,   15,  4,   9,   0,  129, 115, 101, 0,   4,   12,  23,  17,  18,  6,   0,   131, 97,  105, 110, 115, 0,   22,  17,  8,   6,   17, 18,  6,   0,  133, 115, 101, 110, 115, 117, 115, 0,   74,  86,  3,   11,  96,  3,   15,  118, 3,   17,  129, 3,   22,  218, 3,   24,  232, 3,   0,   11,  24,  4,   6,   0,   130, 103, 104, 116, 0,   71,  103, 3,  10,  110, 3,   0,   12,  26,  0,   129, 116, 104, 0,   17, 8,   15,  0,  129, 116, 104, 0,   22,  24,  8,   21,  0,   131, 115, 117, 108, 116, 0,   68,  139, 3,   8,   150, 3,   22,  210, 3,   0,   21,  4,   19,  19, 4,   0,   130, 101, 110, 116, 0,   85,  157,
-                                                                  3,   25,  200, 3,   0,  68, 164, 3,  21,  175, 3,   0,   19,  4,   0,  132, 112, 97, 114, 101, 110, 116, 0,   4,   19, 0,   68,  185, 3,   19,  193, 3,   0,   133, 112, 97,  114, 101, 110, 116, 0,   4,   0,  131, 101, 110, 116, 0,   8,   15,  8,   21,  0,  130, 97, 110, 116, 0,   18,  6,   0,   130, 110, 115, 116, 0,  12,  9,   8,   17,  4,   16,  0,   132, 105, 102, 101, 115, 116, 0,   83,  239, 3,   23,  6,   4,   0,   87, 246, 3,   24, 254, 3,   0,   17,  12,  0,   131, 112, 117, 116, 0,   18,  0,   130, 116, 112, 117, 116, 0,   19,  24,  18,  0,   131, 116, 112, 117, 116, 0,   70,  29,  4,   8,   41,  4,   11,  51,  4,   21,  69, 4,   0,   8,   24,  20,  8,   21,  9,   0,   129, 110, 99, 121, 0,   23, 9,   4,   22,  0,   130, 101, 116, 121, 0,   6,   21,  4,   21,  12,  8,   11,  0,   135, 105, 101, 114, 97,  114, 99,  104, 121, 0,   4,   5,  12,  15,  0,   130, 114, 97,  114, 121, 0};
+static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {19, 0, 0, 44, 60, 0, 4, 144, 0, 5, 82, 1, 6, 106, 1, 7, 36, 2, 9, 60, 2, 10, 183, 2, 11, 247, 2, 12, 41, 3, 15, 134, 3, 16, 3, 4, 17, 31, 4, 18, 81, 4, 19, 193, 4, 21, 17, 5, 22, 186, 5, 23, 82, 6, 24, 109, 6, 26, 131, 6, 2, 0, 0, 10, 69, 0, 23, 87, 0, 88, 183, 2, 68, 223, 2, 74, 226, 2, 72, 183, 2, 131, 97, 117, 103, 101, 0, 2, 82, 6, 11, 96, 0, 24, 133, 0, 2, 85, 6, 8, 105, 0, 12, 122, 0, 108, 250, 2, 87, 60, 0, 75, 87, 0, 72, 96, 0, 108, 105, 0, 132, 0, 72, 41, 3, 85, 0, 0, 130, 101, 105, 114, 0, 85, 109, 6, 72, 17, 5, 130, 114, 117, 101, 0, 3, 0, 0, 6, 156, 0, 19, 226, 0, 20, 62, 1, 2, 106, 1, 6, 165, 0, 18, 194, 0, 82, 106, 1, 80, 198, 1, 82, 3, 4, 71, 81, 4, 68, 36, 2, 87, 144, 0, 72, 82, 6, 132, 109, 111, 100, 97, 116, 101, 0, 80, 198, 1, 80, 3, 4, 82, 3, 4, 71, 81, 4, 68, 36, 2, 87, 144, 0, 72, 82, 6, 135, 99, 111, 109, 109, 111, 100, 97, 116, 101, 0, 2, 193, 4, 4, 235, 0, 19, 22, 1, 85, 144, 0, 2, 17, 5, 8, 247, 0, 21, 5, 1, 81, 20, 5, 87, 31, 4, 132, 112, 97, 114, 101, 110, 116, 0, 72, 17, 5, 81, 20, 5, 87, 31, 4, 133, 112, 97, 114, 101, 110, 116, 0, 68, 193, 4, 85, 144, 0, 2, 17, 5, 4, 37, 1, 21, 48, 1, 81, 144, 0, 87, 31, 4, 130, 101, 110, 116, 0, 72, 17, 5, 81, 20, 5, 87, 31, 4, 131, 101, 110, 116, 0, 88, 0, 0, 76, 109, 6, 85, 41, 3, 72, 17, 5, 132, 99, 113, 117, 105, 114, 101, 0, 72, 0, 0, 70, 0, 0, 88, 106, 1, 68, 109, 6, 86, 144, 0, 72, 186, 5, 131, 97, 117, 115, 101, 0, 4, 0, 0, 4, 121, 1, 11, 138, 1, 12, 175, 1, 18, 198, 1, 88, 144, 0, 75, 109, 6, 74, 247, 2, 87, 183, 2, 130, 103, 104, 116, 0, 2, 247, 2, 8, 147, 1, 18, 158, 1, 76, 250, 2, 73, 253, 2, 130, 105, 101, 102, 0, 82, 81, 4, 86, 81, 4, 72, 186, 5, 81, 221, 5, 131, 115, 101, 110, 0, 72, 41, 3, 79, 0, 0, 76, 134, 3, 81, 162, 3, 74, 44, 3, 133, 101, 105, 108, 105, 110, 103, 0, 3, 81, 4, 15, 210, 1, 17, 231, 1, 22, 25, 2, 79, 134, 3, 72, 134, 3, 74, 146, 3, 88, 183, 2, 72, 223, 2, 130, 97, 103, 117, 101, 0, 2, 31, 4, 6, 240, 1, 23, 7, 2, 72, 106, 1, 81, 0, 0, 86, 31, 4, 88, 186, 5, 86, 109, 6, 133, 115, 101, 110, 115, 117, 115, 0, 76, 82, 6, 68, 41, 3, 81, 144, 0, 86, 31, 4, 131, 97, 105, 110, 115, 0, 81, 186, 5, 87, 31, 4, 130, 110, 115, 116, 0, 72, 0, 0, 85, 0, 0, 89, 17, 5, 76, 0, 0, 72, 41, 3, 71, 0, 0, 131, 105, 118, 101, 100, 0, 5, 0, 0, 4, 78, 2, 12, 108, 2, 15, 126, 2, 18, 141, 2, 21, 160, 2, 2, 144, 0, 15, 87, 2, 22, 97, 2, 72, 134, 3, 86, 146, 3, 129, 115, 101, 0, 79, 186, 5, 72, 134, 3, 130, 108, 115, 101, 0, 87, 41, 3, 79, 82, 6, 72, 134, 3, 85, 146, 3, 131, 108, 116, 101, 114, 0, 68, 134, 3, 86, 144, 0, 72, 186, 5, 131, 97, 108, 115, 101, 0, 90, 81, 4, 68, 131, 6, 85, 144, 0, 71, 17, 5, 131, 114, 119, 97, 114, 100, 0, 72, 17, 5, 84, 20, 5, 88, 0, 0, 72, 109, 6, 70, 0, 0, 92, 106, 1, 129, 110, 99, 121, 0, 2, 0, 0, 4, 192, 2, 24, 223, 2, 88, 144, 0, 85, 109, 6, 68, 17, 5, 81, 144, 0, 87, 31, 4, 72, 82, 6, 72, 0, 0, 135, 117, 97, 114, 97, 110, 116, 101, 101, 0, 68, 109, 6, 85, 144, 0, 68, 17, 5, 87, 144, 0, 72, 82, 6, 72, 0, 0, 130, 110, 116, 101, 101, 0, 72, 0, 0, 76, 0, 0, 2, 41, 3, 10, 6, 3, 21, 16, 3, 87, 183, 2, 75, 82, 6, 129, 104, 116, 0, 68, 17, 5, 85, 144, 0, 70, 17, 5, 75, 106, 1, 92, 138, 1, 135, 105, 101, 114, 97, 114, 99, 104, 121, 0, 81, 0, 0, 3, 31, 4, 6, 56, 3, 23, 72, 3, 25, 116, 3, 79, 106, 1, 88, 134, 3, 72, 109, 6, 71, 0, 0, 129, 100, 101, 0, 2, 82, 6, 8, 81, 3, 19, 105, 3, 85, 0, 0, 68, 17, 5, 87, 144, 0, 82, 82, 6, 85, 81, 4, 135, 116, 101, 114, 97, 116, 111, 114, 0, 88, 193, 4, 87, 109, 6, 131, 112, 117, 116, 0, 79, 0, 0, 76, 134, 3, 68, 162, 3, 71, 174, 3, 131, 97, 108, 105, 100, 0, 3, 0, 0, 8, 146, 3, 12, 162, 3, 18, 225, 3, 81, 0, 0, 74, 31, 4, 75, 183, 2, 87, 247, 2, 129, 116, 104, 0, 3, 41, 3, 4, 174, 3, 5, 192, 3, 22, 207, 3, 86, 144, 0, 76, 186, 5, 82, 246, 5, 81, 81, 4, 131, 105, 115, 111, 110, 0, 68, 82, 1, 85, 144, 0, 92, 17, 5, 130, 114, 97, 114, 121, 0, 87, 186, 5, 81, 8, 6, 72, 31, 4, 85, 0, 0, 130, 101, 110, 101, 114, 0, 82, 81, 4, 2, 81, 4, 22, 237, 3, 24, 251, 3, 72, 186, 5, 86, 221, 5, 108, 186, 5, 132, 115, 101, 115, 0, 83, 139, 4, 129, 107, 117, 112, 0, 68, 0, 0, 81, 144, 0, 72, 31, 4, 73, 0, 0, 76, 60, 2, 86, 108, 2, 87, 186, 5, 132, 105, 102, 101, 115, 116, 0, 68, 0, 0, 80, 144, 0, 72, 3, 4, 86, 0, 0, 2, 186, 5, 4, 52, 4, 19, 67, 4, 83, 204, 5, 70, 226, 0, 72, 106, 1, 131, 112, 97, 99, 101, 0, 70, 193, 4, 68, 106, 1, 72, 121, 1, 130, 97, 99, 101, 0, 3, 0, 0, 6, 93, 4, 24, 139, 4, 25, 172, 4, 70, 106, 1, 2, 106, 1, 4, 105, 4, 24, 125, 4, 86, 121, 1, 86, 186, 5, 76, 186, 5, 82, 246, 5, 81, 81, 4, 131, 105, 111, 110, 0, 85, 109, 6, 72, 17, 5, 71, 20, 5, 129, 114, 101, 100, 0, 83, 109, 6, 2, 193, 4, 23, 151, 4, 24, 163, 4, 88, 82, 6, 87, 109, 6, 131, 116, 112, 117, 116, 0, 87, 109, 6, 130, 116, 112, 117, 116, 0, 72, 0, 0, 85, 0, 0, 76, 17, 5, 71, 41, 3, 72, 36, 2, 130, 114, 105, 100, 101, 0, 3, 0, 0, 18, 205, 4, 21, 227, 4, 22, 255, 4, 86, 81, 4, 87, 186, 5, 76, 8, 6, 82, 17, 6, 81, 81, 4, 131, 105, 116, 105, 111, 110, 0, 76, 17, 5, 89, 41, 3, 76, 0, 0, 79, 41, 3, 72, 134, 3, 71, 146, 3, 74, 36, 2, 72, 183, 2, 130, 103, 101, 0, 88, 186, 5, 72, 109, 6, 71, 0, 0, 82, 36, 2, 131, 101, 117, 100, 111, 0, 72, 0, 0, 6, 0, 0, 6, 41, 5, 9, 59, 5, 15, 76, 5, 19, 96, 5, 23, 126, 5, 24, 153, 5, 76, 106, 1, 72, 175, 1, 89, 178, 1, 72, 0, 0, 131, 101, 105, 118, 101, 0, 72, 60, 2, 85, 0, 0, 72, 17, 5, 71, 20, 5, 129, 114, 101, 100, 0, 72, 134, 3, 89, 146, 3, 72, 0, 0, 81, 0, 0, 87, 31, 4, 130, 97, 110, 116, 0, 76, 193, 4, 87, 41, 3, 76, 82, 6, 87, 41, 3, 76, 82, 6, 82, 41, 3, 81, 81, 4, 134, 101, 116, 105, 116, 105, 111, 110, 0, 2, 82, 6, 21, 135, 5, 24, 146, 5, 88, 17, 5, 81, 109, 6, 130, 117, 114, 110, 0, 81, 109, 6, 128, 114, 110, 0, 2, 109, 6, 22, 162, 5, 23, 174, 5, 79, 186, 5, 87, 134, 3, 131, 115, 117, 108, 116, 0, 85, 82, 6, 81, 17, 5, 131, 116, 117, 114, 110, 0, 5, 0, 0, 4, 204, 5, 8, 221, 5, 12, 246, 5, 23, 8, 6, 26, 45, 6, 73, 144, 0, 87, 60, 2, 72, 82, 6, 92, 0, 0, 130, 101, 116, 121, 0, 83, 0, 0, 72, 193, 4, 85, 0, 0, 68, 17, 5, 87, 144, 0, 72, 82, 6, 132, 97, 114, 97, 116, 101, 0, 81, 41, 3, 74, 44, 3, 72, 183, 2, 71, 0, 0, 131, 103, 110, 101, 100, 0, 2, 82, 6, 12, 17, 6, 21, 32, 6, 85, 41, 3, 81, 17, 5, 74, 31, 4, 131, 114, 105, 110, 103, 0, 76, 17, 5, 74, 41, 3, 81, 183, 2, 129, 110, 103, 0, 2, 131, 6, 12, 54, 6, 23, 67, 6, 87, 134, 6, 75, 82, 6, 70, 85, 6, 129, 99, 104, 0, 76, 82, 6, 70, 41, 3, 75, 106, 1, 131, 105, 116, 99, 104, 0, 75, 0, 0, 85, 247, 2, 72, 17, 5, 86, 20, 5, 82, 186, 5, 79, 81, 4, 71, 134, 3, 130, 104, 111, 108, 100, 0, 71, 0, 0, 83, 36, 2, 68, 193, 4, 87, 144, 0, 72, 82, 6, 132, 112, 100, 97, 116, 101, 0, 76, 0, 0, 71, 41, 3, 75, 36, 2, 87, 247, 2, 129, 116, 104, 0};
@@ -0,0 +1,201 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "autocorrect_flash.h"
+#include <string.h>
+#include "flash.h"
+#include "compiler_support.h"
+#include "debug.h"
+
+#ifdef __AVR__
+#    error "Autocorrect dictionaries in external flash are not supported on AVR"
+#endif
+
+#ifdef FLASH_DRIVER_SPI
+#    include "flash_spi.h"
+#    ifndef AUTOCORRECT_FLASH_SECTOR_SIZE
+#        define AUTOCORRECT_FLASH_SECTOR_SIZE EXTERNAL_FLASH_SECTOR_SIZE
+#    endif
+#endif
+
+#ifndef AUTOCORRECT_FLASH_SECTOR_SIZE
+#    define AUTOCORRECT_FLASH_SECTOR_SIZE (4 * 1024L)
+#endif
+
+STATIC_ASSERT((AUTOCORRECT_FLASH_ADDRESS % AUTOCORRECT_FLASH_SECTOR_SIZE) == 0, "AUTOCORRECT_FLASH_ADDRESS must be aligned to a flash sector");
+
+static autocorrect_flash_header_t dictionary;
+static bool                       dictionary_valid      = false;
+static bool                       dictionary_probed     = false;
+static uint8_t                    dictionary_generation = 0;
+
+// Least recently used lines of the trie, `cache_line` is the line index plus one, 0 when unused
+static uint8_t  cache_data[AUTOCORRECT_FLASH_CACHE_LINES][AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+static uint32_t cache_line[AUTOCORRECT_FLASH_CACHE_LINES];
+static uint16_t cache_used[AUTOCORRECT_FLASH_CACHE_LINES];
+static uint16_t cache_clock = 0;
+static uint8_t  cache_last  = 0;
+
+// Upload in progress, `upload_erased` is how far the image has been erased
+static bool     uploading = false;
+static uint32_t upload_size;
+static uint32_t upload_offset;
+static uint32_t upload_erased;
+static uint32_t upload_magic;
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+static bool autocorrect_flash_header_is_valid(const autocorrect_flash_header_t *header) {
+    return header->magic == AUTOCORRECT_FLASH_MAGIC && header->version == AUTOCORRECT_FLASH_VERSION && (header->link_size == 2 || header->link_size == 3) && header->max_length <= AUTOCORRECT_FLASH_MAX_LENGTH && header->page_size >= sizeof(autocorrect_flash_header_t) && header->page_size % AUTOCORRECT_FLASH_CACHE_LINE_SIZE == 0 && header->size > 0 && header->size <= AUTOCORRECT_FLASH_MAX_SIZE - header->page_size;
+}
+
+static void autocorrect_flash_load(void) {
+    memset(cache_line, 0, sizeof(cache_line));
+    dictionary_valid = flash_read_range(AUTOCORRECT_FLASH_ADDRESS, &dictionary, sizeof(dictionary)) == FLASH_STATUS_SUCCESS && autocorrect_flash_header_is_valid(&dictionary);
+    dictionary_generation++;
+}
+
+const autocorrect_flash_header_t *autocorrect_flash_dictionary(void) {
+    if (!dictionary_probed) {
+        dictionary_probed = true;
+        flash_init();
+        autocorrect_flash_load();
+    }
+    return dictionary_valid ? &dictionary : NULL;
+}
+
+uint8_t autocorrect_flash_generation(void) {
+    return dictionary_generation;
+}
+
+static uint8_t autocorrect_flash_fill_line(uint32_t line) {
+    uint8_t victim = 0;
+    for (uint8_t i = 1; i < AUTOCORRECT_FLASH_CACHE_LINES; i++) {
+        if ((uint16_t)(cache_clock - cache_used[i]) > (uint16_t)(cache_clock - cache_used[victim])) {
+            victim = i;
+        }
+    }
+
+    // Lines never cross a page, as the page size is a multiple of the line size
+    uint32_t offset = line * AUTOCORRECT_FLASH_CACHE_LINE_SIZE;
+    uint32_t length = MIN(AUTOCORRECT_FLASH_CACHE_LINE_SIZE, dictionary.size - offset);
+    if (flash_read_range(AUTOCORRECT_FLASH_ADDRESS + dictionary.page_size + offset, cache_data[victim], length) != FLASH_STATUS_SUCCESS) {
+        // Reads as an empty root, which stops the match
+        memset(cache_data[victim], 0, sizeof(cache_data[victim]));
+        cache_line[victim] = 0;
+        return victim;
+    }
+    cache_line[victim] = line + 1;
+    return victim;
+}
+
+uint8_t autocorrect_flash_read_byte(uint32_t offset) {
+    if (!dictionary_valid || offset >= dictionary.size) {
+        return 0;
+    }
+
+    uint32_t line = offset / AUTOCORRECT_FLASH_CACHE_LINE_SIZE + 1;
+    if (cache_line[cache_last] != line) {
+        uint8_t i = 0;
+        while (i < AUTOCORRECT_FLASH_CACHE_LINES && cache_line[i] != line) {
+            i++;
+        }
+        cache_last             = i < AUTOCORRECT_FLASH_CACHE_LINES ? i : autocorrect_flash_fill_line(line - 1);
+        cache_used[cache_last] = ++cache_clock;
+    }
+    return cache_data[cache_last][offset % AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+}
+
+bool autocorrect_flash_write_begin(uint32_t size) {
+    autocorrect_flash_dictionary();
+    uploading = false;
+    if (size < sizeof(autocorrect_flash_header_t) || size > AUTOCORRECT_FLASH_MAX_SIZE) {
+        return false;
+    }
+
+    // Erasing the header sector drops the current dictionary straight away
+    if (flash_erase_sector(AUTOCORRECT_FLASH_ADDRESS) != FLASH_STATUS_SUCCESS) {
+        autocorrect_flash_load();
+        return false;
+    }
+    autocorrect_flash_load();
+
+    uploading     = true;
+    upload_size   = size;
+    upload_offset = 0;
+    upload_erased = AUTOCORRECT_FLASH_SECTOR_SIZE;
+    return true;
+}
+
+bool autocorrect_flash_write(uint32_t offset, const uint8_t *data, uint8_t length) {
+    if (!uploading || offset != upload_offset || length > upload_size - offset) {
+        return false;
+    }
+
+    while (upload_erased < offset + length) {
+        if (flash_erase_sector(AUTOCORRECT_FLASH_ADDRESS + upload_erased) != FLASH_STATUS_SUCCESS) {
+            uploading = false;
+            return false;
+        }
+        upload_erased += AUTOCORRECT_FLASH_SECTOR_SIZE;
+    }
+
+    // The magic number is held back until the image has been verified, erased flash reads as 0xFF
+    uint8_t buffer[UINT8_MAX];
+    memcpy(buffer, data, length);
+    for (uint32_t i = offset; i < sizeof(upload_magic) && i < offset + length; i++) {
+        ((uint8_t *)&upload_magic)[i] = buffer[i - offset];
+        buffer[i - offset]            = 0xFF;
+    }
+
+    if (flash_write_range(AUTOCORRECT_FLASH_ADDRESS + offset, buffer, length) != FLASH_STATUS_SUCCESS) {
+        uploading = false;
+        return false;
+    }
+    upload_offset += length;
+    return true;
+}
+
+bool autocorrect_flash_write_end(void) {
+    if (!uploading || upload_offset != upload_size) {
+        uploading = false;
+        return false;
+    }
+    uploading = false;
+
+    autocorrect_flash_header_t header;
+    if (flash_read_range(AUTOCORRECT_FLASH_ADDRESS, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    header.magic = upload_magic;
+    if (!autocorrect_flash_header_is_valid(&header) || header.page_size + header.size != upload_size) {
+        dprintf("autocorrect: uploaded dictionary is invalid\n");
+        return false;
+    }
+
+    // Checked against what was actually written rather than what was received
+    uint32_t hash = 0x811C9DC5;
+    uint8_t  buffer[64];
+    for (uint32_t offset = 0; offset < header.size; offset += sizeof(buffer)) {
+        uint32_t length = MIN(sizeof(buffer), header.size - offset);
+        if (flash_read_range(AUTOCORRECT_FLASH_ADDRESS + header.page_size + offset, buffer, length) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+        hash = fnv1a(hash, buffer, length);
+    }
+    if (hash != header.checksum) {
+        dprintf("autocorrect: uploaded dictionary checksum mismatch\n");
+        return false;
+    }
+
+    if (flash_write_range(AUTOCORRECT_FLASH_ADDRESS, &upload_magic, sizeof(upload_magic)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    autocorrect_flash_load();
+    return dictionary_valid;
+}
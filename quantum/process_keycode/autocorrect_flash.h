@@ -0,0 +1,97 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+
+// Where the dictionary lives in external flash, must be sector aligned
+#ifndef AUTOCORRECT_FLASH_ADDRESS
+#    define AUTOCORRECT_FLASH_ADDRESS 0
+#endif
+
+// Space reserved for the dictionary, header included
+#ifndef AUTOCORRECT_FLASH_MAX_SIZE
+#    define AUTOCORRECT_FLASH_MAX_SIZE (256 * 1024L)
+#endif
+
+// RAM cache of the dictionary, the page size of an image has to be a multiple of the line size
+#ifndef AUTOCORRECT_FLASH_CACHE_LINE_SIZE
+#    define AUTOCORRECT_FLASH_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef AUTOCORRECT_FLASH_CACHE_LINES
+#    define AUTOCORRECT_FLASH_CACHE_LINES 16
+#endif
+
+// Longest typo an uploaded dictionary may have, sizes the typo buffer
+#ifndef AUTOCORRECT_FLASH_MAX_LENGTH
+#    define AUTOCORRECT_FLASH_MAX_LENGTH 32
+#endif
+
+#define AUTOCORRECT_FLASH_MAGIC 0x44434151 // "QACD"
+#define AUTOCORRECT_FLASH_VERSION 1
+
+/**
+ * @brief header in the first page of a dictionary image, the paged trie follows in the next one
+ */
+typedef struct PACKED {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  link_size;
+    uint8_t  min_length;
+    uint8_t  max_length;
+    uint32_t size;
+    uint16_t page_size;
+    uint16_t reserved;
+    uint32_t checksum; // FNV-1a of the trie
+} autocorrect_flash_header_t;
+
+/**
+ * @brief the dictionary in external flash, loaded on first use
+ *
+ * @return header of the dictionary, or NULL if there is no valid one
+ */
+const autocorrect_flash_header_t *autocorrect_flash_dictionary(void);
+
+/**
+ * @brief changes every time a dictionary is loaded or erased, so users of the data can tell
+ */
+uint8_t autocorrect_flash_generation(void);
+
+/**
+ * @brief reads a byte of the trie through the cache
+ *
+ * @param offset offset in the trie, as used by its links
+ */
+uint8_t autocorrect_flash_read_byte(uint32_t offset);
+
+/**
+ * @brief starts the upload of a new dictionary image, the current one is erased
+ *
+ * @param size size of the image, header page included
+ * @return false if the image doesn't fit in `AUTOCORRECT_FLASH_MAX_SIZE` or the flash failed
+ */
+bool autocorrect_flash_write_begin(uint32_t size);
+
+/**
+ * @brief writes the next part of the image being uploaded
+ *
+ * Parts have to be written in order, sectors are erased as the upload reaches them.
+ *
+ * @param offset offset in the image, has to follow the previous part
+ * @return false if out of order, past the end of the image or the flash failed
+ */
+bool autocorrect_flash_write(uint32_t offset, const uint8_t *data, uint8_t length);
+
+/**
+ * @brief verifies the uploaded image and makes it the current dictionary
+ *
+ * The magic number is written last, so an interrupted upload never becomes a
+ * dictionary.
+ *
+ * @return false if the image is incomplete or invalid, there is no dictionary then
+ */
+bool autocorrect_flash_write_end(void);
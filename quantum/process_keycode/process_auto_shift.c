@@ -19,6 +19,7 @@
 #include "action_util.h"
 #include "timer.h"
 #include "keycodes.h"
+#include "deadline.h"
 
 #ifndef AUTO_SHIFT_DISABLED_AT_STARTUP
 #    define AUTO_SHIFT_STARTUP_STATE true /* enabled */
@@ -148,6 +149,27 @@ static void autoshift_flush_shift(void) {
     send_keyboard_report();
 }
 
+static void autoshift_deadline(void);
+
+/** \brief Sets the deadline of the key in progress, when it is shifted without being released */
+static void autoshift_schedule(void) {
+    if (!autoshift_flags.in_progress) {
+        deadline_cancel(DEADLINE_AUTO_SHIFT);
+        return;
+    }
+    // clang-format off
+    const uint16_t timeout =
+#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
+        get_autoshift_timeout(autoshift_lastkey, &autoshift_lastrecord)
+#else
+        autoshift_timeout
+#endif
+    ;
+    // clang-format on
+    // autoshift_time is the low half of the 32 bit timer at the time of the press
+    deadline_set(DEADLINE_AUTO_SHIFT, timer_read32() - TIMER_DIFF_16(timer_read(), autoshift_time) + timeout, autoshift_deadline);
+}
+
 /** \brief Record the press of an autoshiftable key
  *
  *  \return Whether the record should be further processed.
@@ -223,6 +245,7 @@ static bool autoshift_press(uint16_t keycode, uint16_t now, keyrecord_t *record)
     autoshift_lastkey           = keycode;
     autoshift_time              = now;
     autoshift_flags.in_progress = true;
+    autoshift_schedule();
 
 #if !defined(NO_ACTION_ONESHOT) && !defined(NO_ACTION_TAPPING)
     clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
@@ -243,6 +266,7 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
     if (autoshift_flags.in_progress && (keycode == autoshift_lastkey || keycode == KC_NO)) {
         // Process the auto-shiftable key.
         autoshift_flags.in_progress = false;
+        deadline_cancel(DEADLINE_AUTO_SHIFT);
         // clang-format off
         autoshift_flags.lastshifted =
             autoshift_flags.lastshifted
@@ -321,6 +345,12 @@ void autoshift_matrix_scan(void) {
     }
 }
 
+static void autoshift_deadline(void) {
+    autoshift_matrix_scan();
+    // The timeout may have been changed in the meantime
+    autoshift_schedule();
+}
+
 void autoshift_toggle(void) {
     autoshift_flags.enabled = !autoshift_flags.enabled;
     autoshift_flush_shift();
@@ -361,6 +391,7 @@ __attribute__((weak)) uint16_t get_autoshift_timeout(uint16_t keycode, keyrecord
 
 void set_autoshift_timeout(uint16_t timeout) {
     autoshift_timeout = timeout;
+    autoshift_schedule();
 }
 
 bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
@@ -497,6 +528,7 @@ void retroshift_poll_time(keyevent_t *event) {
 void retroshift_swap_times(void) {
     if (autoshift_flags.in_progress) {
         autoshift_time = last_retroshift_time;
+        autoshift_schedule();
     }
 }
 #endif
@@ -11,6 +11,10 @@
 #include "keycode_config.h"
 #include "send_string.h"
 #include "action_util.h"
+#include "util.h"
+#ifdef AUTOCORRECT_DATA_FLASH
+#    include "autocorrect_flash.h"
+#endif
 
 #if __has_include("autocorrect_data.h")
 #    include "autocorrect_data.h"
@@ -19,8 +23,42 @@
 #    include "autocorrect_data_default.h"
 #endif
 
-static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
-static uint8_t typo_buffer_size                    = 1;
+#ifndef AUTOCORRECT_LINK_SIZE
+#    error "autocorrect_data.h was generated for an older version of autocorrect, regenerate it with `qmk generate-autocorrect-data`"
+#endif
+
+#if defined(AUTOCORRECT_DATA_FLASH) || AUTOCORRECT_LINK_SIZE > 2
+typedef uint32_t autocorrect_state_t;
+#else
+typedef uint16_t autocorrect_state_t;
+#endif
+
+#ifdef AUTOCORRECT_DATA_FLASH
+// An uploaded dictionary may have longer typos than the built in one
+#    define TYPO_BUFFER_SIZE MAX(AUTOCORRECT_MAX_LENGTH, AUTOCORRECT_FLASH_MAX_LENGTH)
+#    define CORRECTION_BUFFER_SIZE (TYPO_BUFFER_SIZE + 10)
+
+// The dictionary in external flash replaces the built in one once a valid one has been uploaded
+static bool                dictionary_in_flash   = false;
+static uint8_t             dictionary_generation = 0;
+static autocorrect_state_t dictionary_size       = DICTIONARY_SIZE;
+static uint8_t             dictionary_link_size  = AUTOCORRECT_LINK_SIZE;
+#else
+#    define TYPO_BUFFER_SIZE AUTOCORRECT_MAX_LENGTH
+#    define CORRECTION_BUFFER_SIZE 10
+
+static const autocorrect_state_t dictionary_size      = DICTIONARY_SIZE;
+static const uint8_t             dictionary_link_size = AUTOCORRECT_LINK_SIZE;
+#endif
+
+// Ring buffer of the last keys typed, `typo_buffer_head` is the oldest one
+static uint8_t typo_buffer[TYPO_BUFFER_SIZE] = {KC_SPC};
+static uint8_t typo_buffer_head              = 0;
+static uint8_t typo_buffer_size              = 1;
+
+// Trie state after the keys in the buffer, only valid while `typo_state_size` matches `typo_buffer_size`
+static autocorrect_state_t typo_state      = 0;
+static uint8_t             typo_state_size = 0;
 
 /**
  * @brief function for querying the enabled state of autocorrect
@@ -61,6 +99,89 @@ void autocorrect_toggle(void) {
     eeconfig_update_keymap(&keymap_config);
 }
 
+static inline uint8_t typo_buffer_at(uint8_t index) {
+    return typo_buffer[(typo_buffer_head + index) % TYPO_BUFFER_SIZE];
+}
+
+#ifdef AUTOCORRECT_DATA_FLASH
+/**
+ * @brief switches to the dictionary in external flash when one is loaded or replaced
+ */
+static void autocorrect_update_dictionary(void) {
+    const autocorrect_flash_header_t *flash = autocorrect_flash_dictionary();
+    if (autocorrect_flash_generation() == dictionary_generation) {
+        return;
+    }
+    dictionary_generation = autocorrect_flash_generation();
+    dictionary_in_flash   = flash != NULL;
+    dictionary_size       = flash ? flash->size : DICTIONARY_SIZE;
+    dictionary_link_size  = flash ? flash->link_size : AUTOCORRECT_LINK_SIZE;
+    // States of the old trie mean nothing in the new one
+    typo_buffer_size = 0;
+    typo_state       = 0;
+    typo_state_size  = 0;
+}
+#endif
+
+static inline uint8_t autocorrect_read_byte(autocorrect_state_t offset) {
+#ifdef AUTOCORRECT_DATA_FLASH
+    if (dictionary_in_flash) {
+        return autocorrect_flash_read_byte(offset);
+    }
+#endif
+    return pgm_read_byte(autocorrect_data + offset);
+}
+
+static inline autocorrect_state_t autocorrect_read_link(autocorrect_state_t offset) {
+    autocorrect_state_t link = autocorrect_read_byte(offset) | autocorrect_read_byte(offset + 1) << 8;
+#if defined(AUTOCORRECT_DATA_FLASH) || AUTOCORRECT_LINK_SIZE > 2
+    if (dictionary_link_size > 2) {
+        link |= (autocorrect_state_t)autocorrect_read_byte(offset + 2) << 16;
+    }
+#endif
+    return link;
+}
+
+/**
+ * @brief advances the Aho-Corasick state of the `autocorrect_data` trie by one key
+ *
+ * Failure links are followed until a node has a child for `keycode`, which
+ * costs a constant number of steps per key on average, however long the typos.
+ *
+ * @param state offset of the node for the longest typo prefix typed so far
+ * @param keycode the key that was typed
+ * @return offset of the node for the longest typo prefix including `keycode`
+ */
+static autocorrect_state_t autocorrect_next_state(autocorrect_state_t state, uint8_t keycode) {
+    while (state < dictionary_size) {
+        uint8_t code = autocorrect_read_byte(state);
+        if (code & 128) {
+            // Matches are handled as soon as they are reached, start over
+            if (state == 0) {
+                break;
+            }
+            state = 0;
+            continue;
+        } else if (code & 64) { // Node with a single child, stored right after it.
+            if ((code & 63) == keycode) {
+                return state + 1 + dictionary_link_size;
+            }
+        } else { // Node with multiple children.
+            autocorrect_state_t child = state + 1 + dictionary_link_size;
+            for (; code; --code, child += 1 + dictionary_link_size) {
+                if (autocorrect_read_byte(child) == keycode) {
+                    return autocorrect_read_link(child + 1);
+                }
+            }
+        }
+        if (state == 0) {
+            break;
+        }
+        state = autocorrect_read_link(state + 1);
+    }
+    return 0;
+}
+
 /**
  * @brief handler for user to override whether autocorrect should process this keypress
  *
@@ -226,6 +347,10 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         return true;
     }
 
+#ifdef AUTOCORRECT_DATA_FLASH
+    autocorrect_update_dictionary();
+#endif
+
     // autocorrect keycode verification and extraction
     if (!process_autocorrect_user(&keycode, record, &typo_buffer_size, &mods)) {
         return true;
@@ -266,110 +391,110 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
     }
 
-    // Rotate oldest character if buffer is full.
-    if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
-        memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
-        typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
+    // The state has to be rebuilt from the buffer after a backspace or a reset
+    if (typo_state_size != typo_buffer_size) {
+        typo_state = 0;
+        for (uint8_t i = 0; i < typo_buffer_size; ++i) {
+            typo_state = autocorrect_next_state(typo_state, typo_buffer_at(i));
+        }
+    }
+
+    // Overwrite the oldest character if buffer is full.
+    if (typo_buffer_size >= TYPO_BUFFER_SIZE) {
+        typo_buffer_head = (typo_buffer_head + 1) % TYPO_BUFFER_SIZE;
+        typo_buffer_size = TYPO_BUFFER_SIZE - 1;
     }
 
     // Append `keycode` to buffer.
-    typo_buffer[typo_buffer_size++] = keycode;
-    // Return if buffer is smaller than the shortest word.
-    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
+    typo_buffer[(typo_buffer_head + typo_buffer_size++) % TYPO_BUFFER_SIZE] = keycode;
+    typo_state                                                            = autocorrect_next_state(typo_state, keycode);
+    typo_state_size                                                       = typo_buffer_size;
+
+    // Stop if `state` becomes an invalid index. This should not normally
+    // happen, it is a safeguard in case of a bug, data corruption, etc.
+    if (typo_state >= dictionary_size) {
+        typo_state_size = 0;
         return true;
     }
 
-    // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
-            }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
-
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
-        }
-
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char   *changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
+    uint8_t code = autocorrect_read_byte(typo_state);
+    if (code & 128) { // A typo was found! Apply autocorrect.
+        const uint8_t backspaces = (code & 63) + !record->event.pressed;
+        const char   *changes    = (const char *)(autocorrect_data + typo_state + 1);
+#ifdef AUTOCORRECT_DATA_FLASH
+        // Corrections from flash are copied to RAM, which is also where
+        // PROGMEM lives on the platforms that support external flash.
+        char changes_buffer[CORRECTION_BUFFER_SIZE];
+        if (dictionary_in_flash) {
+            for (uint8_t i = 0; i < sizeof(changes_buffer); ++i) {
+                changes_buffer[i] = i < sizeof(changes_buffer) - 1 ? autocorrect_read_byte(typo_state + 1 + i) : 0;
+                if (!changes_buffer[i]) {
                     break;
                 }
-
-                ++typo_len;
             }
+            changes = changes_buffer;
+        }
+#endif
 
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
+        /* Gather info about the typo'd word
+         *
+         * Since buffer may contain several words, delimited by spaces, we
+         * iterate from the end to find the start and length of the typo
+         */
+        char typo[TYPO_BUFFER_SIZE + 1] = {0}; // extra char for null terminator
+
+        uint8_t typo_len   = 0;
+        uint8_t typo_start = 0;
+        bool    space_last = typo_buffer_at(typo_buffer_size - 1) == KC_SPC;
+        for (uint8_t i = typo_buffer_size; i > 0; --i) {
+            // stop counting after finding space (unless it is the last thing)
+            if (typo_buffer_at(i - 1) == KC_SPC && i != typo_buffer_size) {
+                typo_start = i;
+                break;
             }
 
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
+            ++typo_len;
+        }
 
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
-            }
+        // when detecting 'typo:', reduce the length of the string by one
+        if (space_last) {
+            --typo_len;
+        }
 
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
+        // convert buffer of keycodes into a string
+        for (uint8_t i = 0; i < typo_len; ++i) {
+            typo[i] = typo_buffer_at(typo_start + i) - KC_A + 'a';
+        }
+
+        /* Gather the corrected word
+         *
+         * A) Correction of 'typo:' -- Code takes into account
+         * an extra backspace to delete the space (which we dont copy)
+         * for this reason the offset is correct to "skip" the null terminator
+         *
+         * B) When correcting 'typo' -- Need extra offset for terminator
+         */
+        char correct[TYPO_BUFFER_SIZE + CORRECTION_BUFFER_SIZE] = {0}; // let's hope this is big enough
+
+        uint8_t offset = space_last ? backspaces : backspaces + 1;
+        strcpy(correct, typo);
+        strcpy_P(correct + typo_len - offset, changes);
+
+        if (apply_autocorrect(backspaces, changes, typo, correct)) {
+            for (uint8_t i = 0; i < backspaces; ++i) {
+                tap_code(KC_BSPC);
             }
+            send_string_P(changes);
+        }
+
+        typo_buffer_head = 0;
+        if (keycode == KC_SPC) {
+            typo_buffer[0]   = KC_SPC;
+            typo_buffer_size = 1;
+            return true;
+        } else {
+            typo_buffer_size = 0;
+            return false;
         }
     }
     return true;
@@ -18,15 +18,38 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
 #include "wait.h"
+#include "timer.h"
+#include "util.h"
+#include "compiler_support.h"
+#include "deadline.h"
+#include "eeconfig.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
 
+#ifndef DYNAMIC_MACRO_DELAY
+#    define DYNAMIC_MACRO_DELAY 0
+#endif
+
+// Played events are at least a millisecond apart, one per main loop at most
+#define DYNAMIC_MACRO_PLAY_INTERVAL MAX(DYNAMIC_MACRO_DELAY, 1)
+
+// Bytes of a persisted macro read from NVM at a time during playback
+#ifndef DYNAMIC_MACRO_NVM_READ_AHEAD
+#    define DYNAMIC_MACRO_NVM_READ_AHEAD 16
+#endif
+
+// Key events held back while a macro plays, further presses are ignored
+#ifndef DYNAMIC_MACRO_PLAY_QUEUE_SIZE
+#    define DYNAMIC_MACRO_PLAY_QUEUE_SIZE 8
+#endif
+
 // default feedback method
 void dynamic_macro_led_blink(void) {
 #ifdef BACKLIGHT_ENABLE
@@ -82,25 +105,457 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+__attribute__((weak)) void dynamic_macro_play_queue_full_kb(keyrecord_t *record) {
+    dynamic_macro_play_queue_full_user(record);
+}
+
+__attribute__((weak)) void dynamic_macro_play_queue_full_user(keyrecord_t *record) {
+    dynamic_macro_led_blink();
+}
+
+/* Macros are identified by their slot internally, 0 for macro 1 and
+ * 1 for macro 2, and by their direction in the hooks.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+#define DYNAMIC_MACRO_DIRECTION(SLOT) ((SLOT) == 0 ? +1 : -1)
+
+/* Recorded events are stored as a stream of bytes:
+ *
+ *   [flags] [tap]? [keycode low] [keycode high]? [row << 4 | col] or [row] [col] [time]...
+ *
+ * The flags hold whether the key is pressed, the event type, and which
+ * of the optional fields follow. The time is the number of milliseconds
+ * since the previous event, 7 bits per byte starting with the lowest,
+ * with the top bit set on all but the last byte.
+ *
+ * An ordinary key event takes three bytes this way, against the whole
+ * keyrecord_t that used to be stored.
+ */
+#define DYNAMIC_MACRO_EVENT_PRESSED 0x80
+#define DYNAMIC_MACRO_EVENT_TAP 0x40
+#define DYNAMIC_MACRO_EVENT_TYPE_SHIFT 3
+#define DYNAMIC_MACRO_EVENT_TYPE_MASK 0x38
+#define DYNAMIC_MACRO_EVENT_KEYCODE 0x04
+#define DYNAMIC_MACRO_EVENT_WIDE_KEY 0x02
+
+// flags, tap, keycode, row and column, and a 16 bit time
+#define DYNAMIC_MACRO_EVENT_MAX_SIZE 9
+
+#ifndef NO_ACTION_TAPPING
+STATIC_ASSERT(sizeof(tap_t) == 1, "tap_t is stored as a single byte");
+#endif
+
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+
+/**
+ * Encode a key event.
+ *
+ * @param data[out]  At least DYNAMIC_MACRO_EVENT_MAX_SIZE bytes.
+ * @param record[in] The event.
+ * @param delta[in]  Milliseconds since the previous event.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *data, keyrecord_t *record, uint16_t delta) {
+    uint8_t size = 1;
+
+    data[0] = (record->event.pressed ? DYNAMIC_MACRO_EVENT_PRESSED : 0) | ((record->event.type << DYNAMIC_MACRO_EVENT_TYPE_SHIFT) & DYNAMIC_MACRO_EVENT_TYPE_MASK);
+#ifndef NO_ACTION_TAPPING
+    uint8_t tap;
+    memcpy(&tap, &record->tap, sizeof(tap));
+    if (tap != 0) {
+        data[0] |= DYNAMIC_MACRO_EVENT_TAP;
+        data[size++] = tap;
+    }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode != KC_NO) {
+        data[0] |= DYNAMIC_MACRO_EVENT_KEYCODE;
+        data[size++] = record->keycode & 0xFF;
+        data[size++] = record->keycode >> 8;
+    }
+#endif
+    if (record->event.key.row < 16 && record->event.key.col < 16) {
+        data[size++] = record->event.key.row << 4 | record->event.key.col;
+    } else {
+        data[0] |= DYNAMIC_MACRO_EVENT_WIDE_KEY;
+        data[size++] = record->event.key.row;
+        data[size++] = record->event.key.col;
+    }
+    do {
+        data[size] = delta & 0x7F;
+        delta >>= 7;
+        if (delta != 0) {
+            data[size] |= 0x80;
+        }
+        size++;
+    } while (delta != 0);
+
+    return size;
+}
+
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *  <- macro_length[0] ->      <-------- macro_length[1] ------->
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * When the macros are persisted, they are laid out the same way in
+ * NVM, both written left-to-right after their lengths, and played
+ * from there. The buffer is then only used by the recording.
+ */
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* Length in bytes of each macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+#    define DYNAMIC_MACRO_NVM_DATA_SIZE ((EECONFIG_DYNAMIC_MACRO_SIZE) - sizeof(macro_length))
+
+STATIC_ASSERT((EECONFIG_DYNAMIC_MACRO_SIZE) > sizeof(macro_length) && (EECONFIG_DYNAMIC_MACRO_SIZE) <= UINT16_MAX, "DYNAMIC_MACRO_NVM_SIZE must be between 5 and 65535");
+
+static bool macro_length_loaded = false;
+
+/**
+ * Offset in NVM of a byte of a persisted macro.
+ */
+static uint16_t dynamic_macro_nvm_offset(uint8_t slot, uint16_t index) {
+    return sizeof(macro_length) + (slot == 0 ? 0 : DYNAMIC_MACRO_NVM_DATA_SIZE - macro_length[1]) + index;
+}
+#endif
+
+/**
+ * Read the lengths of the persisted macros, once.
+ */
+static void dynamic_macro_load(void) {
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    if (macro_length_loaded) {
+        return;
+    }
+    macro_length_loaded = true;
+
+    eeconfig_read_dynamic_macro(macro_length, 0, sizeof(macro_length));
+    if ((uint32_t)macro_length[0] + macro_length[1] > DYNAMIC_MACRO_NVM_DATA_SIZE) {
+        dprintln("dynamic macro: discarding invalid persisted macros");
+        macro_length[0] = 0;
+        macro_length[1] = 0;
+    }
+#endif
+}
+
+/**
+ * Write the macro just recorded to NVM.
+ */
+static void dynamic_macro_save(uint8_t slot) {
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    // Emptied first, so that losing power halfway doesn't leave a partial macro
+    uint16_t empty = 0;
+    eeconfig_update_dynamic_macro(&empty, slot * sizeof(uint16_t), sizeof(empty));
+    eeconfig_update_dynamic_macro(macro_buffer, dynamic_macro_nvm_offset(slot, 0), macro_length[slot]);
+    eeconfig_update_dynamic_macro(&macro_length[slot], slot * sizeof(uint16_t), sizeof(uint16_t));
+#endif
+}
+
+/**
+ * A byte of the macro being recorded.
+ */
+static uint8_t *dynamic_macro_buffer_at(uint8_t slot, uint16_t index) {
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    return &macro_buffer[index];
+#else
+    return slot == 0 ? &macro_buffer[index] : &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - 1 - index];
+#endif
+}
+
+/**
+ * The number of bytes a macro can be recorded into, leaving the other macro untouched.
+ */
+static uint16_t dynamic_macro_capacity(uint8_t slot) {
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    return MIN(DYNAMIC_MACRO_BUFFER_SIZE, DYNAMIC_MACRO_NVM_DATA_SIZE - macro_length[!slot]);
+#else
+    return DYNAMIC_MACRO_BUFFER_SIZE - macro_length[!slot];
+#endif
+}
 
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
 static layer_state_t dm1_layer_state;
 static layer_state_t dm2_layer_state;
 #endif
 
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* Bytes recorded so far, and up to the last key release, as the keys
+ * still held when stopping the recording are not saved. */
+static uint16_t record_length  = 0;
+static uint16_t record_trimmed = 0;
+
+/* Time of the last event recorded. */
+static uint16_t record_time = 0;
+
+/* Playback state of a macro. A macro can play the other one, which
+ * is played in full before resuming the first one. */
+typedef struct {
+    keyrecord_t   next;
+    uint16_t      next_delta;
+    bool          done;
+    uint8_t       slot;
+    uint16_t      position;
+    uint16_t      length;
+    layer_state_t saved_layer_state;
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    uint16_t cache_position;
+    uint8_t  cache_length;
+    uint8_t  cache[DYNAMIC_MACRO_NVM_READ_AHEAD];
+#endif
+} dynamic_macro_player_t;
+
+static dynamic_macro_player_t players[2];
+static uint8_t                player_depth = 0;
+
+// When the next event of the innermost macro is due
+static uint32_t player_deadline = 0;
+
+/* Key events from the keyboard wait until the playback has finished,
+ * so that they neither interleave with the macro nor see the layer
+ * state it plays on. */
+static keyrecord_t play_queue[DYNAMIC_MACRO_PLAY_QUEUE_SIZE];
+static uint8_t     play_queue_length = 0;
+// Held back presses whose release is still to come, each keeps a slot free for it
+static uint8_t play_queue_presses = 0;
+static bool    playing_event      = false;
+
+/**
+ * Read the next byte of a macro being played, 0 past its end.
+ */
+static uint8_t dynamic_macro_player_read(dynamic_macro_player_t *player) {
+    if (player->position >= player->length) {
+        return 0;
+    }
+    uint16_t position = player->position++;
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    if ((uint16_t)(position - player->cache_position) >= player->cache_length) {
+        player->cache_position = position;
+        player->cache_length   = MIN(DYNAMIC_MACRO_NVM_READ_AHEAD, player->length - position);
+        eeconfig_read_dynamic_macro(player->cache, dynamic_macro_nvm_offset(player->slot, position), player->cache_length);
+    }
+    return player->cache[position - player->cache_position];
+#else
+    return *dynamic_macro_buffer_at(player->slot, position);
+#endif
+}
+
+/**
+ * Decode the next event of a macro being played.
+ *
+ * @return false if the macro has no more events.
+ */
+static bool dynamic_macro_player_next(dynamic_macro_player_t *player) {
+    if (player->position >= player->length) {
+        return false;
+    }
+
+    keyrecord_t *record = &player->next;
+    uint8_t      flags  = dynamic_macro_player_read(player);
+
+    memset(record, 0, sizeof(keyrecord_t));
+    record->event.pressed = flags & DYNAMIC_MACRO_EVENT_PRESSED;
+    record->event.type    = (flags & DYNAMIC_MACRO_EVENT_TYPE_MASK) >> DYNAMIC_MACRO_EVENT_TYPE_SHIFT;
+    if (flags & DYNAMIC_MACRO_EVENT_TAP) {
+        uint8_t tap = dynamic_macro_player_read(player);
+#ifndef NO_ACTION_TAPPING
+        memcpy(&record->tap, &tap, sizeof(tap));
+#else
+        (void)tap;
+#endif
+    }
+    if (flags & DYNAMIC_MACRO_EVENT_KEYCODE) {
+        uint16_t keycode = dynamic_macro_player_read(player);
+        keycode |= dynamic_macro_player_read(player) << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+    if (flags & DYNAMIC_MACRO_EVENT_WIDE_KEY) {
+        record->event.key.row = dynamic_macro_player_read(player);
+        record->event.key.col = dynamic_macro_player_read(player);
+    } else {
+        uint8_t key           = dynamic_macro_player_read(player);
+        record->event.key.row = key >> 4;
+        record->event.key.col = key & 0x0F;
+    }
+
+    player->next_delta = 0;
+    for (uint8_t shift = 0; shift < 16; shift += 7) {
+        uint8_t byte = dynamic_macro_player_read(player);
+        player->next_delta |= (uint16_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Milliseconds until the next event of a macro being played.
+ */
+static uint32_t dynamic_macro_player_delay(dynamic_macro_player_t *player) {
+#ifdef DYNAMIC_MACRO_KEEP_TIMING
+    return MAX(player->next_delta, DYNAMIC_MACRO_PLAY_INTERVAL);
+#else
+    return DYNAMIC_MACRO_PLAY_INTERVAL;
+#endif
+}
+
+/**
+ * Process the key events that arrived during the playback.
+ */
+static void dynamic_macro_play_queue_flush(void) {
+    keyrecord_t queue[DYNAMIC_MACRO_PLAY_QUEUE_SIZE];
+    uint8_t     length = play_queue_length;
+
+    // Copied out first, as an event may start playing a macro and be followed by more to hold back
+    memcpy(queue, play_queue, length * sizeof(keyrecord_t));
+    play_queue_length  = 0;
+    play_queue_presses = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        process_record(&queue[i]);
+    }
+}
+
+/**
+ * Finish playing the innermost macro.
+ */
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_player_t *player = &players[--player_depth];
+
+    clear_keyboard();
+
+    layer_state_set(player->saved_layer_state);
+
+    dynamic_macro_play_kb(DYNAMIC_MACRO_DIRECTION(player->slot));
+
+    if (player_depth == 0) {
+        dynamic_macro_play_queue_flush();
+    }
+}
+
+/**
+ * Play an event of the innermost macro once it is due.
+ */
+static void dynamic_macro_play_deadline(void) {
+    if (player_depth > 0) {
+        dynamic_macro_player_t *player = &players[player_depth - 1];
+        keyrecord_t             record = player->next;
+
+        player->done      = !dynamic_macro_player_next(player);
+        record.event.time = timer_read();
+        // May start playing the other macro
+        playing_event = true;
+        process_record(&record);
+        playing_event = false;
+    }
+
+    while (player_depth > 0 && players[player_depth - 1].done) {
+        dynamic_macro_play_end();
+    }
+
+    // Unless the event started playing the other macro, which has set its own deadline
+    if (player_depth > 0 && !deadline_pending(DEADLINE_DYNAMIC_MACRO)) {
+        // Counted from when the event was due, so that a late main loop does not stretch the macro
+        player_deadline += dynamic_macro_player_delay(&players[player_depth - 1]);
+        deadline_set(DEADLINE_DYNAMIC_MACRO, player_deadline, dynamic_macro_play_deadline);
+    }
+}
+
+/**
+ * Whether a macro is being played.
+ *
+ * @param slot[in] 0 or 1 for macro 1 or 2.
+ */
+static bool dynamic_macro_is_playing_slot(uint8_t slot) {
+    for (uint8_t i = 0; i < player_depth; i++) {
+        if (players[i].slot == slot) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool dynamic_macro_is_playing(void) {
+    return player_depth > 0;
+}
+
+/**
+ * Whether a held back press of the key is still waiting for its release.
+ */
+static bool dynamic_macro_play_queue_is_pressed(keypos_t key) {
+    for (uint8_t i = play_queue_length; i > 0; i--) {
+        if (KEYEQ(play_queue[i - 1].event.key, key)) {
+            return play_queue[i - 1].event.pressed;
+        }
+    }
+    return false;
+}
+
+/**
+ * Hold back a key event from the keyboard while a macro plays, to be
+ * processed once it has finished. Once the queue is full, further
+ * presses are ignored, and it still has room for the releases of the
+ * presses it holds.
+ *
+ * @return true if the event was held back or ignored, and must not be processed now.
+ */
+bool dynamic_macro_hold_back(keyrecord_t *record) {
+    if (player_depth == 0 || playing_event) {
+        return false;
+    }
+
+    if (record->event.pressed) {
+        if (play_queue_length + play_queue_presses + 2 > DYNAMIC_MACRO_PLAY_QUEUE_SIZE) {
+            dprintf("dynamic macro: play queue full, ignoring the press of key %u,%u\n", record->event.key.row, record->event.key.col);
+            dynamic_macro_play_queue_full_kb(record);
+            return true;
+        }
+        play_queue_presses++;
+    } else if (dynamic_macro_play_queue_is_pressed(record->event.key)) {
+        // Its slot was kept free
+        play_queue_presses--;
+    } else if (play_queue_length + play_queue_presses >= DYNAMIC_MACRO_PLAY_QUEUE_SIZE) {
+        // Released from before the playback, or pressed after the queue was full
+        dprintf("dynamic macro: play queue full, ignoring the release of key %u,%u\n", record->event.key.row, record->event.key.col);
+        dynamic_macro_play_queue_full_kb(record);
+        return true;
+    }
+    play_queue[play_queue_length++] = *record;
+    return true;
+}
+
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param slot[in] 0 or 1 for macro 1 or 2.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+static void dynamic_macro_record_start(uint8_t slot) {
+    int8_t direction = DYNAMIC_MACRO_DIRECTION(slot);
+
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
@@ -115,152 +570,126 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     layer_clear();
 #endif
     clear_keyboard();
-    *macro_pointer = macro_buffer;
+
+    dynamic_macro_load();
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) == 0
+    // The recording overwrites the macro straight away
+    macro_length[slot] = 0;
+#endif
+    record_length  = 0;
+    record_trimmed = 0;
 }
 
 /**
- * Play the dynamic macro.
+ * Start playing the dynamic macro. Its events are played one at a
+ * time as they fall due, without holding up the main loop.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param slot[in] 0 or 1 for macro 1 or 2.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+static void dynamic_macro_play(uint8_t slot) {
+    if (dynamic_macro_is_playing_slot(slot)) {
+        dprintln("dynamic macro: ignoring a recursive macro play");
+        return;
+    }
 
-    layer_state_t saved_layer_state = layer_state;
+    dprintf("dynamic macro: slot %d playback\n", slot + 1);
+
+    dynamic_macro_load();
+
+    dynamic_macro_player_t *player = &players[player_depth++];
+    player->slot                   = slot;
+    player->position               = 0;
+    player->length                 = macro_length[slot];
+    player->saved_layer_state      = layer_state;
+#if (EECONFIG_DYNAMIC_MACRO_SIZE) > 0
+    player->cache_length = 0;
+#endif
 
     clear_keyboard();
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
-    if (direction == 1) {
+    if (slot == 0) {
         layer_state_set(dm1_layer_state);
-    } else if (direction == -1) {
+    } else {
         layer_state_set(dm2_layer_state);
     }
 #else
     layer_clear();
 #endif
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+    player->done = !dynamic_macro_player_next(player);
+    if (player->done) {
+        dynamic_macro_play_end();
+        return;
     }
 
-    clear_keyboard();
-
-    layer_state_set(saved_layer_state);
-
-    dynamic_macro_play_kb(direction);
+    if (!deadline_pending(DEADLINE_DYNAMIC_MACRO)) {
+        player_deadline = timer_read32() + dynamic_macro_player_delay(player);
+        deadline_set(DEADLINE_DYNAMIC_MACRO, player_deadline, dynamic_macro_play_deadline);
+    }
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param slot[in]   0 or 1 for macro 1 or 2.
+ * @param record[in] The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(uint8_t slot, keyrecord_t *record) {
+    int8_t direction = DYNAMIC_MACRO_DIRECTION(slot);
+
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && record_length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
+    uint8_t data[DYNAMIC_MACRO_EVENT_MAX_SIZE];
+    uint8_t size = dynamic_macro_encode(data, record, record_length == 0 ? 0 : TIMER_DIFF_16(record->event.time, record_time));
+
+    /* Events that don't fit are dropped rather than overwriting the
+     * other macro.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (size <= dynamic_macro_capacity(slot) - record_length) {
+        for (uint8_t i = 0; i < size; i++) {
+            *dynamic_macro_buffer_at(slot, record_length++) = data[i];
+        }
+        record_time = record->event.time;
+        if (!record->event.pressed) {
+            record_trimmed = record_length;
+        }
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d\n", slot + 1, record_length, dynamic_macro_capacity(slot));
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro, and persist it if enabled.
+ *
+ * @param slot[in] 0 or 1 for macro 1 or 2.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_kb(direction);
+static void dynamic_macro_record_end(uint8_t slot) {
+    dynamic_macro_record_end_kb(DYNAMIC_MACRO_DIRECTION(slot));
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (record_trimmed != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
+    macro_length[slot] = record_trimmed;
+    dynamic_macro_save(slot);
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
-
-    *macro_end = macro_pointer;
+    dprintf("dynamic macro: slot %d saved, length: %d\n", slot + 1, macro_length[slot]);
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
- */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
-
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
-
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
 void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+    if (macro_id != 0) {
+        dynamic_macro_record_end(macro_id - 1);
     }
     macro_id = 0;
 }
@@ -273,18 +702,17 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
-                    return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    if (dynamic_macro_is_playing_slot(keycode - QK_DYNAMIC_MACRO_RECORD_START_1)) {
+                        dprintln("dynamic macro: ignoring the recording of a macro being played");
+                        return false;
+                    }
+                    dynamic_macro_record_start(keycode - QK_DYNAMIC_MACRO_RECORD_START_1);
+                    macro_id = keycode - QK_DYNAMIC_MACRO_RECORD_START_1 + 1;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
-                    return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(keycode - QK_DYNAMIC_MACRO_PLAY_1);
                     return false;
             }
         }
@@ -310,14 +738,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_id - 1, record);
                 }
                 return true;
                 break;
@@ -30,11 +30,20 @@
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
  * so 128 is considered a safe default.
+ *
+ * The size is counted in key records, as events used to be stored
+ * whole. They are now compacted to a few bytes each, so the same RAM
+ * holds several times as many events.
  */
 #ifndef DYNAMIC_MACRO_SIZE
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size of the macro buffer in bytes. */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -47,4 +56,8 @@ bool dynamic_macro_record_end_kb(int8_t direction);
 bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
+void dynamic_macro_play_queue_full_kb(keyrecord_t *record);
+void dynamic_macro_play_queue_full_user(keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+bool dynamic_macro_is_playing(void);
+bool dynamic_macro_hold_back(keyrecord_t *record);
@@ -18,6 +18,7 @@
 #include "process_key_override.h"
 #include "report.h"
 #include "timer.h"
+#include "deadline.h"
 #include "debug.h"
 #include "wait.h"
 #include "action_util.h"
@@ -85,6 +86,17 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+// Key overrides sorted by trigger, and by their position in the list for the same trigger, so those without a trigger (KC_NO) come first. Rebuilt when the number of key overrides changes, or on request.
+static uint8_t *override_index              = NULL;
+static uint8_t  override_index_count        = 0;
+static uint16_t override_index_source_count = UINT16_MAX;
+
+// Range of `override_index` with the same trigger
+typedef struct {
+    uint8_t position;
+    uint8_t end;
+} override_bucket_t;
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -111,6 +123,62 @@ bool key_override_is_enabled(void) {
     return enabled;
 }
 
+void key_override_reindex(void) {
+    override_index_source_count = UINT16_MAX;
+}
+
+static void build_override_index(void) {
+    override_index              = NULL;
+    override_index_count        = 0;
+    override_index_source_count = key_override_count();
+
+    // Overrides added at runtime beyond the ones in the keymap have no room in the index, those are all checked
+    if (override_index_source_count > key_override_count_raw() || override_index_source_count > UINT8_MAX) {
+        return;
+    }
+
+    uint8_t *const index = key_override_index_buffer_raw();
+    for (uint8_t i = 0; i < override_index_source_count; i++) {
+        const key_override_t *const override = key_override_get(i);
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        // Insertion sort, which keeps overrides with the same trigger in the order of the list
+        uint8_t position = override_index_count++;
+        while (position > 0 && key_override_get(index[position - 1])->trigger > override->trigger) {
+            index[position] = index[position - 1];
+            position--;
+        }
+        index[position] = i;
+    }
+    override_index = index;
+}
+
+// First position in the index with a trigger not below `trigger`
+static uint8_t override_index_lower_bound(const uint32_t trigger) {
+    uint8_t low  = 0;
+    uint8_t high = override_index_count;
+    while (low < high) {
+        const uint8_t middle = low + (high - low) / 2;
+        if (key_override_get(override_index[middle])->trigger < trigger) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static override_bucket_t find_override_bucket(const uint16_t trigger) {
+    return (override_bucket_t){
+        .position = override_index_lower_bound(trigger),
+        .end      = override_index_lower_bound((uint32_t)trigger + 1),
+    };
+}
+
 // Returns whether the modifiers that are pressed are such that the override should activate
 static bool key_override_matches_active_modifiers(const key_override_t *override, const uint8_t mods) {
     // Check that negative keys pass
@@ -156,6 +224,12 @@ static void schedule_deferred_register(const uint16_t keycode) {
         defer_delay          = 50; // 50ms
     }
     deferred_register = keycode;
+    deadline_set(DEADLINE_KEY_OVERRIDE, defer_reference_time + defer_delay, key_override_task);
+}
+
+static void cancel_deferred_register(void) {
+    deferred_register = 0;
+    deadline_cancel(DEADLINE_KEY_OVERRIDE);
 }
 
 const key_override_t *clear_active_override(const bool allow_reregister) {
@@ -165,7 +239,7 @@ const key_override_t *clear_active_override(const bool allow_reregister) {
 
     key_override_printf("Deactivating override\n");
 
-    deferred_register = 0;
+    cancel_deferred_register();
 
     // Clear the suppressed mods
     clear_suppressed_override_mods();
@@ -244,152 +318,208 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_override_count() == 0) {
-        return true;
+/** Checks all requirements of the override for activation by the key event, except whether it is already active */
+static bool key_override_should_activate(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0; i < key_override_count(); i++) {
-        const key_override_t *const override = key_override_get(i);
-
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    return true;
+}
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+/** Activates the override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
 
-        key_override_printf("Activating override\n");
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
+
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
+
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
+
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+/** Finds the first override, in the order of the list, that activates for the key event */
+static const key_override_t *find_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    if (key_override_count() != override_index_source_count) {
+        build_override_index();
+    }
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    if (override_index == NULL) {
+        for (uint8_t i = 0; i < key_override_count(); i++) {
+            const key_override_t *const override = key_override_get(i);
+
+            // End of array
+            if (override == NULL) {
+                break;
+            }
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+            if (key_override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                return override;
+            }
         }
+        return NULL;
+    }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    // Only overrides without a trigger, triggered by this key (if it went down) or by the last key pressed can activate
+    override_bucket_t buckets[3];
+    uint8_t           bucket_count = 0;
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
+    buckets[bucket_count++] = find_override_bucket(KC_NO);
+    if (key_down && keycode != KC_NO) {
+        buckets[bucket_count++] = find_override_bucket(keycode);
+    }
+    if (last_key_down != KC_NO && last_key_down != keycode) {
+        buckets[bucket_count++] = find_override_bucket(last_key_down);
+    }
+
+    while (true) {
+        // Overrides are checked in the order of the list, so that the first match takes precedence as without the index
+        override_bucket_t *next = NULL;
+        for (uint8_t i = 0; i < bucket_count; i++) {
+            if (buckets[i].position < buckets[i].end && (next == NULL || override_index[buckets[i].position] < override_index[next->position])) {
+                next = &buckets[i];
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+        }
+        if (next == NULL) {
+            return NULL;
         }
 
-        *activated = true;
+        const key_override_t *const override = key_override_get(override_index[next->position++]);
+        if (key_override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            return override;
+        }
+    }
+}
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+/** Finds the first key override that activates for the key event and activates it. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_override_count() == 0) {
+        *activated = false;
+        return true;
     }
 
-    *activated = false;
+    const key_override_t *const override = find_override(keycode, layer, key_down, is_mod, active_mods);
 
-    return true;
+    *activated = override != NULL;
+
+    return override == NULL || activate_override(override, keycode, key_down, is_mod, active_mods);
 }
 
 void key_override_task(void) {
@@ -459,7 +589,7 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
         if (key_down) {
             last_key_down      = keycode;
             last_key_down_time = timer_read32();
-            deferred_register  = 0;
+            cancel_deferred_register();
         }
 
         // The last key that was pressed was just released. No more keys are therefore sending input
@@ -467,7 +597,7 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
             last_key_down      = 0;
             last_key_down_time = 0;
             // We also cancel any deferred registers because, again, no keys are sending any input. Only the last key that is pressed creates an input – this key was just lifted.
-            deferred_register = 0;
+            cancel_deferred_register();
         }
     }
 
@@ -21,43 +21,77 @@
 #include "action_util.h"
 #include "timer.h"
 #include "wait.h"
+#include "deadline.h"
 #include "keymap_introspection.h"
 
 static uint16_t active_td;
+static uint16_t last_tap_time;
 
 #ifndef TAP_DANCE_MAX_SIMULTANEOUS
 #    define TAP_DANCE_MAX_SIMULTANEOUS 3
 #endif
 
+STATIC_ASSERT(TAP_DANCE_MAX_SIMULTANEOUS < UINT8_MAX, "TAP_DANCE_MAX_SIMULTANEOUS must be below 255");
+
 static tap_dance_state_t tap_dance_states[TAP_DANCE_MAX_SIMULTANEOUS];
 
-static uint16_t last_tap_time;
+// Slots given back by finished tap dances, and how many slots have been handed out at all
+static uint8_t free_slots[TAP_DANCE_MAX_SIMULTANEOUS];
+static uint8_t free_slot_count = 0;
+static uint8_t used_slot_count = 0;
 
-static tap_dance_state_t *tap_dance_get_or_allocate_state(uint8_t tap_dance_idx, bool allocate) {
-    uint8_t i;
-    if (tap_dance_idx >= tap_dance_count()) {
-        return NULL;
+static tap_dance_state_t *tap_dance_find_state(uint8_t tap_dance_idx) {
+    // Each tap dance of the keymap knows its slot plus one, or 0 without one
+    if (tap_dance_idx < tap_dance_count_raw()) {
+        uint8_t slot = tap_dance_slot_buffer_raw()[tap_dance_idx];
+        return slot ? &tap_dance_states[slot - 1] : NULL;
     }
-    // Search for a state already used for this keycode
-    for (i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
+    // Tap dances added at runtime beyond the ones in the keymap have no room for that, those are searched for
+    for (uint8_t i = 0; i < used_slot_count; i++) {
         if (tap_dance_states[i].in_use && tap_dance_states[i].index == tap_dance_idx) {
             return &tap_dance_states[i];
         }
     }
-    // No existing state found; bail out if new state allocation is not allowed
-    if (!allocate) {
+    return NULL;
+}
+
+static tap_dance_state_t *tap_dance_get_or_allocate_state(uint8_t tap_dance_idx, bool allocate) {
+    tap_dance_state_t *state;
+    uint8_t            slot;
+    if (tap_dance_idx >= tap_dance_count()) {
+        return NULL;
+    }
+    state = tap_dance_find_state(tap_dance_idx);
+    // Bail out if no state is used for this keycode and new state allocation is not allowed
+    if (state != NULL || !allocate) {
+        return state;
+    }
+    if (free_slot_count > 0) {
+        slot = free_slots[--free_slot_count];
+    } else if (used_slot_count < TAP_DANCE_MAX_SIMULTANEOUS) {
+        slot = used_slot_count++;
+    } else {
+        // No states are available, tap dance won't happen
         return NULL;
     }
-    // Search for the first available state
-    for (i = 0; i < TAP_DANCE_MAX_SIMULTANEOUS; i++) {
-        if (!tap_dance_states[i].in_use) {
-            tap_dance_states[i].index  = tap_dance_idx;
-            tap_dance_states[i].in_use = true;
-            return &tap_dance_states[i];
+    if (tap_dance_idx < tap_dance_count_raw()) {
+        tap_dance_slot_buffer_raw()[tap_dance_idx] = slot + 1;
+    }
+    state         = &tap_dance_states[slot];
+    state->index  = tap_dance_idx;
+    state->in_use = true;
+    return state;
+}
+
+static void tap_dance_release_state(tap_dance_state_t *state) {
+    if (state->in_use) {
+        if (state->index < tap_dance_count_raw()) {
+            tap_dance_slot_buffer_raw()[state->index] = 0;
         }
+        free_slots[free_slot_count++] = state - tap_dance_states;
     }
-    // No states are available, tap dance won't happen
-    return NULL;
+    // Clear the tap dance state and mark it as unused
+    memset(state, 0, sizeof(tap_dance_state_t));
 }
 
 tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx) {
@@ -145,8 +179,21 @@ static inline void process_tap_dance_action_on_reset(tap_dance_action_t *action,
     del_mods(state->oneshot_mods);
 #endif
     send_keyboard_report();
-    // Clear the tap dance state and mark it as unused
-    memset(state, 0, sizeof(tap_dance_state_t));
+    tap_dance_release_state(state);
+}
+
+static void tap_dance_timeout(void);
+
+static void tap_dance_set_active(uint16_t keycode) {
+    active_td     = keycode;
+    last_tap_time = timer_read();
+    if (!active_td) {
+        deadline_cancel(DEADLINE_TAP_DANCE);
+        return;
+    }
+
+    // The dance finishes once more than the tapping term has passed since its last tap
+    deadline_set(DEADLINE_TAP_DANCE, timer_read32() + GET_TAPPING_TERM(active_td, &(keyrecord_t){}) + 1, tap_dance_timeout);
 }
 
 static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t *action, tap_dance_state_t *state) {
@@ -159,7 +206,7 @@ static inline void process_tap_dance_action_on_dance_finished(tap_dance_action_t
         send_keyboard_report();
         _process_tap_dance_action_fn(state, action->user_data, action->fn.on_dance_finished);
     }
-    active_td = 0;
+    tap_dance_set_active(0);
     if (!state->pressed) {
         // There will not be a key release event, so reset now.
         process_tap_dance_action_on_reset(action, state);
@@ -212,15 +259,14 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
             }
             state->pressed = record->event.pressed;
             if (record->event.pressed) {
-                last_tap_time = timer_read();
                 process_tap_dance_action_on_each_tap(action, state);
-                active_td = state->finished ? 0 : keycode;
+                tap_dance_set_active(state->finished ? 0 : keycode);
             } else {
                 process_tap_dance_action_on_each_release(action, state);
                 if (state->finished) {
                     process_tap_dance_action_on_reset(action, state);
                     if (active_td == keycode) {
-                        active_td = 0;
+                        tap_dance_set_active(0);
                     }
                 }
             }
@@ -231,11 +277,14 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
-void tap_dance_task(void) {
+/**
+ * Finish the active dance, once its tapping term has passed.
+ */
+static void tap_dance_timeout(void) {
     tap_dance_action_t *action;
     tap_dance_state_t  *state;
 
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td) return;
 
     action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
     state  = tap_dance_get_state(QK_TAP_DANCE_GET_INDEX(active_td));
@@ -244,7 +293,13 @@ void tap_dance_task(void) {
     }
 }
 
+void tap_dance_task(void) {
+    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+
+    tap_dance_timeout();
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
-    active_td = 0;
+    tap_dance_set_active(0);
     process_tap_dance_action_on_reset(tap_dance_get(state->index), state);
 }
@@ -105,6 +105,7 @@ tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx);
 
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
 bool process_tap_dance(uint16_t keycode, keyrecord_t *record);
+// Not called by QMK any more, dances are finished from a deadline. Kept for compatibility.
 void tap_dance_task(void);
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data);
@@ -16,6 +16,8 @@
 
 #include "quantum.h"
 #include "process_quantum.h"
+#include "progmem.h"
+#include "util.h"
 
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
@@ -295,160 +297,205 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/** \brief Core keycode function
- *
- * Hands off handling to other quantum/process_keycode/ functions
- */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
-#endif
+typedef bool (*process_record_handler_t)(uint16_t keycode, keyrecord_t *record);
 
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
-#endif
+typedef struct {
+    uint16_t                 first;
+    uint16_t                 last;
+    process_record_handler_t handler;
+} process_record_range_t;
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
-#endif
+// Handlers that act on, or keep track of, every key
+#define PROCESS_RECORD_ALL(handler) {0x0000, 0xFFFF, handler}
+// Handlers that return true for any keycode from outside their range without doing anything
+#define PROCESS_RECORD_RANGE(range, handler) {range, range##_MAX, handler}
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* Handlers in the order they process a key, each with the keycodes it
+ * handles, so that only the ones that can act on a keycode are called. A
+ * basic keycode only goes through the handlers that see every key.
+ */
+// clang-format off
+static const process_record_range_t process_record_handlers[] PROGMEM = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ALL(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_ALL(process_last_key),
+    PROCESS_RECORD_ALL(process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_ALL(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_ALL(process_haptic),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_mouse),
 #endif
-            process_record_modules(keycode, record) && // modules must run before kb
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_ALL(process_record_modules), // modules must run before kb
+    PROCESS_RECORD_ALL(process_record_kb),
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MACRO, process_record_via),
 #endif
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_ALL(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_SEQUENCER, process_sequencer),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MIDI, process_midi),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_AUDIO, process_audio),
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_backlight),
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_led_matrix),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_STENO, process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_RECORD_ALL(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_ALL(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_ALL(process_key_override_handler),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_ALL(process_tap_dance),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+#    ifdef UCIS_ENABLE
+    // Takes every key while a mnemonic is being typed
+    PROCESS_RECORD_ALL(process_unicode_common),
+#    else
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_unicode_common),
+    PROCESS_RECORD_RANGE(QK_UNICODE, process_unicode_common),
+#    endif
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_ALL(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_dynamic_tapping_term),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    // Any other key press interrupts a space cadet key
+    PROCESS_RECORD_ALL(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MAGIC, process_magic),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_grave_esc),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_underglow),
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, process_rgb_matrix),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_JOYSTICK, process_joystick),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_PROGRAMMABLE_BUTTON, process_programmable_button),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_ALL(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_tri_layer),
 #endif
 #if !defined(NO_ACTION_LAYER)
-            process_default_layer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_PERSISTENT_DEF_LAYER, process_default_layer),
 #endif
 #ifdef LAYER_LOCK_ENABLE
-            process_layer_lock(keycode, record) &&
+    PROCESS_RECORD_ALL(process_layer_lock),
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_CONNECTION, process_connection),
 #endif
 #ifndef NO_ACTION_ONESHOT
-            process_oneshot(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_oneshot),
+#endif
+    PROCESS_RECORD_RANGE(QK_QUANTUM, process_quantum),
+};
+// clang-format on
+
+/** \brief Core keycode function
+ *
+ * Hands off handling to other quantum/process_keycode/ functions
+ */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
 #endif
-            process_quantum(keycode, record))) {
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
         return false;
     }
+#endif
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handlers); i++) {
+        if (keycode < pgm_read_word(&process_record_handlers[i].first) || keycode > pgm_read_word(&process_record_handlers[i].last)) {
+            continue;
+        }
+        process_record_handler_t handler = pgm_read_ptr(&process_record_handlers[i].handler);
+        if (!handler(keycode, record)) {
+            return false;
+        }
+    }
 
     return true;
 }
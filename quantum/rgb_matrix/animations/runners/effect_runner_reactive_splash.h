@@ -4,20 +4,41 @@
 
 typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+typedef struct {
+    uint8_t min_dist;
+    uint8_t max_dist;
+} reactive_splash_reach_t;
+
+// Distances from a hit of the given age that the effect can still change, min_dist > max_dist once it can't change any
+typedef reactive_splash_reach_t (*reactive_splash_reach_f)(uint16_t tick);
+
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t                 live_count = 0;
+    uint8_t                 live[LED_HITS_TO_REMEMBER];
+    uint16_t                tick[LED_HITS_TO_REMEMBER];
+    reactive_splash_reach_t reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+        tick[j]  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reach[j] = reach_func ? reach_func(tick[j]) : (reactive_splash_reach_t){0, UINT8_MAX};
+        if (reach[j].min_dist <= reach[j].max_dist) {
+            live[live_count++] = j;
+        }
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         hsv_t hsv = rgb_matrix_config.hsv;
         hsv.v     = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        for (uint8_t k = 0; k < live_count; k++) {
+            uint8_t j  = live[k];
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            if (abs(dx) > reach[j].max_dist || abs(dy) > reach[j].max_dist) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist < reach[j].min_dist || dist > reach[j].max_dist) continue;
+            hsv = effect_func(hsv, dx, dy, dist, tick[j]);
         }
         hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
         rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +47,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -1,4 +1,4 @@
-#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#ifdef ENABLE_RGB_MATRIX_TYPING_HEATMAP
 RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP
@@ -16,85 +16,195 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+// Maximum number of keys that can be warm at the same time, the coldest one is
+// dropped when a press needs a free cell.
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_CELLS
+#            if defined(__AVR__)
+#                define RGB_MATRIX_TYPING_HEATMAP_CELLS 24
+#            else
+#                define RGB_MATRIX_TYPING_HEATMAP_CELLS 64
+#            endif
+#        endif
+
+// Number of neighbors remembered per LED for the spread, 0 scans every key on
+// each press instead.
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS
+#            define RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS 0
+#        endif
+
+// A warm key, its temperature is `value` minus one for every decay step since `step`.
+typedef struct {
+    uint8_t  led;
+    uint8_t  value;
+    uint16_t step;
+} heatmap_cell_t;
+
+static heatmap_cell_t heatmap_cells[RGB_MATRIX_TYPING_HEATMAP_CELLS];
+static uint8_t        heatmap_cell_count;
+
+static inline uint16_t heatmap_step(void) {
+    return g_rgb_timer / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+}
+
+static inline uint8_t heatmap_cell_value(const heatmap_cell_t* cell, uint16_t step) {
+    uint16_t elapsed = step - cell->step;
+    return elapsed >= cell->value ? 0 : cell->value - elapsed;
+}
+
+static void heatmap_add(uint8_t led, uint8_t amount, uint16_t step) {
+    uint8_t coldest       = 0;
+    uint8_t coldest_value = UINT8_MAX;
+    for (uint8_t i = 0; i < heatmap_cell_count; i++) {
+        uint8_t value = heatmap_cell_value(&heatmap_cells[i], step);
+        if (heatmap_cells[i].led == led) {
+            heatmap_cells[i].value = qadd8(value, amount);
+            heatmap_cells[i].step  = step;
+            return;
+        }
+        if (value <= coldest_value) {
+            coldest       = i;
+            coldest_value = value;
+        }
+    }
+
+    if (heatmap_cell_count < RGB_MATRIX_TYPING_HEATMAP_CELLS) {
+        coldest = heatmap_cell_count++;
+    } else if (coldest_value >= amount) {
+        return;
+    }
+    heatmap_cells[coldest] = (heatmap_cell_t){.led = led, .value = amount, .step = step};
+}
+
+static void heatmap_prune(uint16_t step) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < heatmap_cell_count; i++) {
+        if (heatmap_cell_value(&heatmap_cells[i], step) > 0) {
+            heatmap_cells[count++] = heatmap_cells[i];
+        }
+    }
+    heatmap_cell_count = count;
+}
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+static uint8_t heatmap_spread_amount(led_point_t pressed, led_point_t target) {
+    int16_t dx = target.x - pressed.x;
+    int16_t dy = target.y - pressed.y;
+    // cheap bounding box test first, most keys are well outside the spread
+    if (abs(dx) > RGB_MATRIX_TYPING_HEATMAP_SPREAD || abs(dy) > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, sqrt16(dx * dx + dy * dy));
+    return MIN(amount, RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT);
+}
+#        endif
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS > 0
+// Keys within the spread of each LED, warmest first, filled when the effect starts
+static uint8_t heatmap_neighbor_led[RGB_MATRIX_LED_COUNT][RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS];
+static uint8_t heatmap_neighbor_amount[RGB_MATRIX_LED_COUNT][RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS];
+
+static void heatmap_build_neighbors(void) {
+    memset(heatmap_neighbor_amount, 0, sizeof heatmap_neighbor_amount);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) {
+                continue;
+            }
+            for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+                for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                    uint8_t target = g_led_config.matrix_co[i_row][i_col];
+                    if (target == NO_LED || target == led) {
+                        continue;
+                    }
+                    uint8_t amount = heatmap_spread_amount(g_led_config.point[led], g_led_config.point[target]);
+                    if (amount <= heatmap_neighbor_amount[led][RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS - 1]) {
+                        continue;
+                    }
+                    // keep the list sorted so the farthest neighbors are the ones dropped
+                    uint8_t j = RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS - 1;
+                    for (; j > 0 && heatmap_neighbor_amount[led][j - 1] < amount; j--) {
+                        heatmap_neighbor_led[led][j]    = heatmap_neighbor_led[led][j - 1];
+                        heatmap_neighbor_amount[led][j] = heatmap_neighbor_amount[led][j - 1];
+                    }
+                    heatmap_neighbor_led[led][j]    = target;
+                    heatmap_neighbor_amount[led][j] = amount;
+                }
+            }
+        }
+    }
+}
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
-#        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
-    // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-#        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+
+    uint16_t step = heatmap_step();
+    heatmap_add(led, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP, step);
+#        if defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+    // Limit effect to pressed keys
+#        elif RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS > 0
+    for (uint8_t i = 0; i < RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS && heatmap_neighbor_amount[led][i]; i++) {
+        heatmap_add(heatmap_neighbor_led[led][i], heatmap_neighbor_amount[led][i], step);
+    }
+#        else
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+            uint8_t target = g_led_config.matrix_co[i_row][i_col];
+            if (target == NO_LED || target == led) { // skip as target key doesn't have an led position
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int32_t)(led_a.x - led_b.x) * (int32_t)(led_a.x - led_b.x)) + ((int32_t)(led_a.y - led_b.y) * (int32_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = heatmap_spread_amount(g_led_config.point[led], g_led_config.point[target]);
+            if (amount) {
+                heatmap_add(target, amount, step);
             }
         }
     }
 #        endif
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
-
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    if (params->init) {
+    uint16_t step = heatmap_step();
+    // `init` stays set for every iteration of the first frame, only start over once
+    if (params->init && params->iter == 0) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_cell_count = 0;
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS > 0
+        heatmap_build_neighbors();
+#        endif
     }
 
     // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
+    // `RGB_MATRIX_LED_PROCESS_LIMIT` or `RGB_MATRIX_RENDER_BUDGET_US`, therefore we only want to drop
+    // the keys that cooled down when the animation starts.
     if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
-        }
+        heatmap_prune(step);
     }
 
-    // Render heatmap & decrease
-    uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
-            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
-                count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
-                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
-
-                hsv_t hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-                rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
-                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
-            }
+    // Cold keys are black, only the warm ones need a color
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color(i, 0, 0, 0);
+    }
+    for (uint8_t i = 0; i < heatmap_cell_count; i++) {
+        uint8_t led = heatmap_cells[i].led;
+        if (led < led_min || led >= led_max || !HAS_ANY_FLAGS(g_led_config.flags[led], params->flags)) {
+            continue;
         }
+        uint8_t val = heatmap_cell_value(&heatmap_cells[i], step);
+        hsv_t   hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        rgb_t   rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(led, rgb.r, rgb.g, rgb.b);
     }
 
     return rgb_matrix_check_finished_leds(led_max);
 }
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
-#endif     // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#endif     // ENABLE_RGB_MATRIX_TYPING_HEATMAP
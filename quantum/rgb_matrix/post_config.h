@@ -6,8 +6,7 @@
 // clang-format off
 
 // framebuffer
-#if defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP) || \
-    defined(ENABLE_RGB_MATRIX_DIGITAL_RAIN)
+#if defined(ENABLE_RGB_MATRIX_DIGITAL_RAIN)
 #    define RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #endif
 
@@ -22,20 +22,76 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "compiler_support.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
 
 #include <lib/lib8tion/lib8tion.h>
 
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    define RGB_RENDER_TIMESTAMP() ((uint32_t)chVTGetSystemTimeX())
+#    define RGB_RENDER_ELAPSED_US(start) ((uint32_t)TIME_I2US(chVTTimeElapsedSinceX((systime_t)(start))))
+#else
+// Only the millisecond timer is available, so render steps are measured in whole milliseconds
+#    define RGB_RENDER_TIMESTAMP() timer_read32()
+#    define RGB_RENDER_ELAPSED_US(start) (timer_elapsed32(start) * 1000)
+#    if RGB_MATRIX_RENDER_BUDGET_US > 0 && RGB_MATRIX_RENDER_BUDGET_US < 1000
+#        error "RGB_MATRIX_RENDER_BUDGET_US must be at least 1000 on platforms without a microsecond timer"
+#    endif
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+// Distance and angle of each LED relative to k_rgb_matrix_center, see rgb_matrix_update_geometry()
+static uint8_t rgb_matrix_led_dist_cache[RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_matrix_led_angle_cache[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
+static inline uint8_t rgb_matrix_led_distance(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return rgb_matrix_led_dist_cache[i];
+#else
+    int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
+static inline uint8_t rgb_matrix_led_angle(uint8_t i) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return rgb_matrix_led_angle_cache[i];
+#else
+    int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+    return atan2_8(dy, dx);
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
+void rgb_matrix_update_geometry(void) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx                    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy                    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        rgb_matrix_led_dist_cache[i]  = sqrt16(dx * dx + dy * dy);
+        rgb_matrix_led_angle_cache[i] = atan2_8(dy, dx);
+    }
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
 __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+#ifdef RGB_MATRIX_DITHERING
+    // the lightness curve is applied with more precision when flushing
+    return hsv_to_rgb_nocie(hsv);
+#else
     return hsv_to_rgb(hsv);
+#endif // RGB_MATRIX_DITHERING
 }
 
 // Generic effect runners
@@ -43,7 +99,7 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
-#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_EFFECT(name, ...)
 #define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 #include "rgb_matrix_effects.inc"
@@ -62,6 +118,63 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
 // -----End rgb effect includes macros-------
 // ------------------------------------------
 
+static bool rgb_matrix_none(effect_params_t *params);
+
+typedef struct {
+    bool (*render)(effect_params_t *params);
+    uint8_t flags;
+} rgb_matrix_effect_t;
+
+// Effects declared without metadata, such as most community modules and keymap effects, are
+// assumed to be animated and to need both the hit tracker and the framebuffer
+#define RGB_MATRIX_EFFECT_DEFAULT_FLAGS(...) ((__VA_ARGS__ + 0) ? (__VA_ARGS__ + 0) : (RGB_MATRIX_EFFECT_FRAMEBUFFER | RGB_MATRIX_EFFECT_KEYREACTIVE))
+
+// ---------------------------------------------
+// -----Begin rgb effect table macros-----------
+static const rgb_matrix_effect_t rgb_matrix_effects[] PROGMEM = {
+    {rgb_matrix_none, RGB_MATRIX_EFFECT_STATIC},
+#define RGB_MATRIX_EFFECT(name, ...) {name, (__VA_ARGS__ + 0)},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+
+#ifdef COMMUNITY_MODULES_ENABLE
+#    define RGB_MATRIX_EFFECT(name, ...) {name, RGB_MATRIX_EFFECT_DEFAULT_FLAGS(__VA_ARGS__)},
+#    include "rgb_matrix_community_modules.inc"
+#    undef RGB_MATRIX_EFFECT
+#endif
+
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) {name, RGB_MATRIX_EFFECT_DEFAULT_FLAGS(__VA_ARGS__)},
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+};
+// -----End rgb effect table macros-------------
+// ---------------------------------------------
+
+// One entry per enabled effect, in enum order, so disabled effects leave nothing behind
+STATIC_ASSERT(ARRAY_SIZE(rgb_matrix_effects) == RGB_MATRIX_EFFECT_MAX, "RGB Matrix effect table does not match the effect enum");
+
+static bool rgb_matrix_render_effect(uint8_t effect, effect_params_t *params) {
+    if (effect >= RGB_MATRIX_EFFECT_MAX) {
+        return false;
+    }
+    bool (*render)(effect_params_t *params) = pgm_read_ptr(&rgb_matrix_effects[effect].render);
+    return render(params);
+}
+
+uint8_t rgb_matrix_get_effect_flags(uint8_t mode) {
+    if (mode >= RGB_MATRIX_EFFECT_MAX) {
+        return 0;
+    }
+    return pgm_read_byte(&rgb_matrix_effects[mode].flags);
+}
+
 // globals
 rgb_config_t rgb_matrix_config; // TODO: would like to prefix this with g_ for global consistancy, do this in another pr
 uint32_t     g_rgb_timer;
@@ -71,6 +184,10 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_KEY_STATS
+static uint16_t rgb_matrix_key_stats[MATRIX_ROWS][MATRIX_COLS];
+static bool     rgb_matrix_key_stats_dirty = false;
+#endif // RGB_MATRIX_KEY_STATS
 
 #ifndef RGB_MATRIX_FLAG_STEPS
 #    define RGB_MATRIX_FLAG_STEPS {LED_FLAG_ALL, LED_FLAG_KEYLIGHT | LED_FLAG_MODIFIER, LED_FLAG_UNDERGLOW, LED_FLAG_NONE}
@@ -85,6 +202,20 @@ static uint8_t         rgb_last_effect    = UINT8_MAX;
 static uint8_t         rgb_current_effect = 0;
 static effect_params_t rgb_effect_params  = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state     = SYNCING;
+#ifdef RGB_MATRIX_STATIC_RENDER_ONCE
+static uint64_t rgb_rendered_config = 0; // config the current static effect was last flushed with
+#endif // RGB_MATRIX_STATIC_RENDER_ONCE
+
+// render scheduling
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+static struct rgb_matrix_limits_t rgb_render_limits;
+static uint8_t                    rgb_render_chunk    = MAX(RGB_MATRIX_LED_PROCESS_LIMIT, 1);
+static uint32_t                   rgb_render_led_cost = 0; // average cost of one LED, in 1/16 microseconds
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+static uint32_t                  rgb_render_stats_timer;
+static uint16_t                  rgb_render_frames;
+static uint16_t                  rgb_render_worst_us;
+static rgb_matrix_render_stats_t rgb_render_stats;
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -165,12 +296,345 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
     return index;
 }
 
+#if RGB_MATRIX_OVERLAY_LAYERS > 0 || RGB_MATRIX_TRANSITION_MS > 0 || defined(RGB_MATRIX_DITHERING) || RGB_MATRIX_CURRENT_LIMIT_MA > 0
+#    define RGB_MATRIX_COMPOSITOR
+#endif
+
+#ifdef RGB_MATRIX_COMPOSITOR
+// Effects render into the effect layer, which is blended with the outgoing effect during a transition
+// and covered by the overlays when flushing. Only LEDs marked dirty since the last flush are sent to
+// the driver.
+static rgb_t   rgb_effect_layer[RGB_MATRIX_LED_COUNT];
+static rgb_t  *rgb_render_target = rgb_effect_layer;
+static uint8_t rgb_composite_dirty[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static bool    rgb_composite_pending = false;
+
+static inline void rgb_matrix_mark_dirty(uint8_t index) {
+    rgb_composite_dirty[index / 8] |= 1 << (index % 8);
+    rgb_composite_pending = true;
+}
+
+static void rgb_matrix_mark_all_dirty(void) {
+    memset(rgb_composite_dirty, 0xFF, sizeof(rgb_composite_dirty));
+    rgb_composite_pending = true;
+}
+#endif // RGB_MATRIX_COMPOSITOR
+
+#if RGB_MATRIX_OVERLAY_LAYERS > 0
+STATIC_ASSERT(RGB_MATRIX_OVERLAY_LAYERS <= 8, "RGB_MATRIX_OVERLAY_LAYERS must not exceed 8");
+
+static rgb_t   rgb_overlay_color[RGB_MATRIX_OVERLAY_LAYERS][RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_overlay_alpha[RGB_MATRIX_OVERLAY_LAYERS][RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_overlay_visible    = 0;
+static uint8_t rgb_overlay_composited = 0; // layers that were visible in the last composite
+
+void rgb_matrix_overlay_set_color(uint8_t layer, uint8_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+    if (layer >= RGB_MATRIX_OVERLAY_LAYERS || index >= RGB_MATRIX_LED_COUNT) return;
+
+    rgb_t *color = &rgb_overlay_color[layer][index];
+    if (rgb_overlay_alpha[layer][index] == alpha && color->r == red && color->g == green && color->b == blue) return;
+
+    *color                          = (rgb_t){.r = red, .g = green, .b = blue};
+    rgb_overlay_alpha[layer][index] = alpha;
+    if (rgb_overlay_visible & (1 << layer)) {
+        rgb_matrix_mark_dirty(index);
+    }
+}
+
+void rgb_matrix_overlay_clear(uint8_t layer) {
+    if (layer >= RGB_MATRIX_OVERLAY_LAYERS) return;
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (rgb_overlay_alpha[layer][i] && (rgb_overlay_visible & (1 << layer))) {
+            rgb_matrix_mark_dirty(i);
+        }
+        rgb_overlay_alpha[layer][i] = 0;
+    }
+}
+
+void rgb_matrix_overlay_set_visible(uint8_t layer, bool visible) {
+    if (layer >= RGB_MATRIX_OVERLAY_LAYERS || rgb_matrix_overlay_is_visible(layer) == visible) return;
+
+    rgb_overlay_visible ^= 1 << layer;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (rgb_overlay_alpha[layer][i]) {
+            rgb_matrix_mark_dirty(i);
+        }
+    }
+}
+
+bool rgb_matrix_overlay_is_visible(uint8_t layer) {
+    return layer < RGB_MATRIX_OVERLAY_LAYERS && (rgb_overlay_visible & (1 << layer));
+}
+#endif // RGB_MATRIX_OVERLAY_LAYERS > 0
+
+#if RGB_MATRIX_TRANSITION_MS > 0
+static rgb_t           rgb_transition_layer[RGB_MATRIX_LED_COUNT]; // frames of the outgoing effect
+static uint8_t         rgb_transition_effect = 0;                  // outgoing effect, 0 when not transitioning
+static uint32_t        rgb_transition_start;
+static effect_params_t rgb_transition_params;
+
+// Blends two colors with two multiplies per pixel instead of three: red and blue share one 32-bit
+// lane, with eight bits of headroom each, and green gets its own. amount_of_b ranges over 0..256
+// so that both ends are exact.
+static inline rgb_t rgb_matrix_blend(rgb_t a, rgb_t b, uint16_t amount_of_b) {
+    uint32_t pa          = ((uint32_t)a.r << 16) | ((uint32_t)a.g << 8) | a.b;
+    uint32_t pb          = ((uint32_t)b.r << 16) | ((uint32_t)b.g << 8) | b.b;
+    uint16_t amount_of_a = 256 - amount_of_b;
+    uint32_t rb          = (((pa & 0xFF00FF) * amount_of_a + (pb & 0xFF00FF) * amount_of_b) >> 8) & 0xFF00FF;
+    uint32_t g           = (((pa & 0x00FF00) * amount_of_a + (pb & 0x00FF00) * amount_of_b) >> 8) & 0x00FF00;
+    uint32_t p           = rb | g;
+    return (rgb_t){.r = p >> 16, .g = p >> 8, .b = p};
+}
+
+static void rgb_matrix_transition_begin(uint8_t outgoing) {
+    // the outgoing effect keeps rendering on top of its last frame, as if nothing happened
+    memcpy(rgb_transition_layer, rgb_effect_layer, sizeof(rgb_transition_layer));
+    rgb_transition_effect = outgoing;
+    rgb_transition_start  = g_rgb_timer;
+    rgb_transition_params = (effect_params_t){.flags = rgb_effect_params.flags};
+}
+#endif // RGB_MATRIX_TRANSITION_MS > 0
+
+#ifdef RGB_MATRIX_DITHERING
+// CIE 1931 lightness curve scaled to 0..255 << 8, the low byte is spread over successive frames
+// clang-format off
+static const uint16_t rgb_matrix_lightness_curve[256] PROGMEM = {
+        0,    28,    57,    85,   113,   142,   170,   198,   227,   255,   283,   312,   340,   368,   397,   425,
+      453,   482,   510,   538,   567,   595,   625,   655,   686,   719,   752,   786,   821,   858,   895,   934,
+      973,  1014,  1056,  1098,  1143,  1188,  1234,  1282,  1331,  1381,  1432,  1484,  1538,  1593,  1649,  1707,
+     1766,  1826,  1888,  1951,  2016,  2082,  2149,  2218,  2288,  2359,  2433,  2507,  2583,  2661,  2740,  2821,
+     2903,  2987,  3073,  3160,  3248,  3339,  3431,  3525,  3620,  3717,  3816,  3917,  4019,  4123,  4229,  4337,
+     4446,  4558,  4671,  4786,  4903,  5021,  5142,  5265,  5389,  5516,  5644,  5775,  5907,  6042,  6178,  6317,
+     6457,  6600,  6745,  6891,  7040,  7191,  7345,  7500,  7658,  7817,  7979,  8143,  8310,  8479,  8649,  8823,
+     8998,  9176,  9356,  9539,  9724,  9911, 10100, 10292, 10487, 10684, 10883, 11085, 11289, 11496, 11705, 11917,
+    12131, 12348, 12568, 12790, 13014, 13241, 13471, 13704, 13939, 14177, 14417, 14661, 14907, 15155, 15407, 15661,
+    15918, 16178, 16441, 16706, 16974, 17245, 17519, 17796, 18076, 18359, 18645, 18933, 19225, 19519, 19817, 20117,
+    20421, 20728, 21037, 21350, 21666, 21985, 22307, 22632, 22960, 23292, 23626, 23964, 24305, 24650, 24997, 25348,
+    25702, 26059, 26420, 26784, 27151, 27521, 27895, 28273, 28653, 29037, 29425, 29816, 30210, 30608, 31009, 31414,
+    31823, 32234, 32650, 33069, 33491, 33917, 34347, 34780, 35217, 35658, 36102, 36550, 37002, 37457, 37916, 38379,
+    38845, 39315, 39789, 40267, 40749, 41234, 41724, 42217, 42714, 43215, 43720, 44229, 44741, 45258, 45779, 46303,
+    46832, 47364, 47901, 48441, 48986, 49535, 50088, 50645, 51206, 51771, 52340, 52914, 53491, 54073, 54659, 55250,
+    55844, 56443, 57046, 57653, 58265, 58881, 59501, 60125, 60754, 61388, 62025, 62667, 63314, 63965, 64620, 65280,
+};
+// clang-format on
+
+// A color in 0..255 << 8 steps, kept until the dither so the curve doesn't lose its precision
+typedef struct {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} rgb_level_t;
+
+static uint8_t rgb_dither_error[RGB_MATRIX_LED_COUNT][3];
+// LEDs last set outside of effect rendering, such as by indicators, whose colors are already final
+static uint8_t rgb_dither_raw[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static bool    rgb_dither_rendering = false;
+
+static inline void rgb_matrix_dither_set_raw(uint8_t index, bool raw) {
+    if (raw) {
+        rgb_dither_raw[index / 8] |= 1 << (index % 8);
+    } else {
+        rgb_dither_raw[index / 8] &= ~(1 << (index % 8));
+    }
+}
+
+// The curve is applied to the value of the color, and every channel is scaled by the same ratio so that
+// the hue and saturation are kept
+static rgb_level_t rgb_matrix_lightness(rgb_t color, bool raw) {
+    if (raw) {
+        return (rgb_level_t){color.r << 8, color.g << 8, color.b << 8};
+    }
+    uint8_t value = MAX(color.r, MAX(color.g, color.b));
+    if (!value) {
+        return (rgb_level_t){0, 0, 0};
+    }
+    uint32_t ratio = ((uint32_t)pgm_read_word(&rgb_matrix_lightness_curve[value]) << 8) / value;
+    return (rgb_level_t){color.r * ratio >> 8, color.g * ratio >> 8, color.b * ratio >> 8};
+}
+
+static inline uint16_t rgb_matrix_blend_level(uint16_t level, uint8_t color, uint8_t alpha) {
+    return ((uint32_t)level * (256 - alpha) + ((uint32_t)color << 8) * alpha) >> 8;
+}
+
+static inline uint8_t rgb_matrix_dither(uint16_t level, uint8_t *error) {
+    level += *error;
+    *error = level & 0xFF;
+    return level >> 8;
+}
+#endif // RGB_MATRIX_DITHERING
+
+#if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+// Composited colors before limiting, and the running sum of all their channels. Only LEDs that change
+// update the sum, so estimating the draw of a frame does not need a pass over every LED.
+static rgb_t                    rgb_output_layer[RGB_MATRIX_LED_COUNT];
+static uint32_t                 rgb_output_level  = 0;
+static uint16_t                 rgb_output_scale  = 256;
+static uint32_t                 rgb_power_average = 0; // average_ma << 6
+static rgb_matrix_power_stats_t rgb_power_stats   = {0};
+
+// The sum of all channels is at most RGB_MATRIX_LED_COUNT * 3 * 255, so the requested current is at most
+// RGB_MATRIX_LED_COUNT * 3 * RGB_MATRIX_CHANNEL_CURRENT_MA, and both have to be scaled in 32 bits.
+STATIC_ASSERT((uint64_t)RGB_MATRIX_LED_COUNT * 3 * UINT8_MAX * RGB_MATRIX_CHANNEL_CURRENT_MA <= UINT32_MAX, "RGB_MATRIX_CHANNEL_CURRENT_MA is too large for the LED count");
+STATIC_ASSERT((uint64_t)RGB_MATRIX_CURRENT_LIMIT_MA * 256 <= UINT32_MAX, "RGB_MATRIX_CURRENT_LIMIT_MA is too large");
+
+static inline uint32_t rgb_matrix_level_current_ma(uint32_t level) {
+    return level * RGB_MATRIX_CHANNEL_CURRENT_MA / UINT8_MAX;
+}
+
+static void rgb_matrix_update_power(void) {
+    uint32_t requested = rgb_matrix_level_current_ma(rgb_output_level);
+    uint16_t scale     = requested > RGB_MATRIX_CURRENT_LIMIT_MA ? (uint32_t)RGB_MATRIX_CURRENT_LIMIT_MA * 256 / requested : 256;
+    if (scale != rgb_output_scale) {
+        // every LED is dimmed by the same amount
+        rgb_output_scale = scale;
+        rgb_matrix_mark_all_dirty();
+    }
+
+    rgb_power_stats.requested_ma = MIN(requested, UINT16_MAX);
+    rgb_power_stats.current_ma   = requested * scale / 256;
+    rgb_power_stats.peak_ma      = MAX(rgb_power_stats.peak_ma, rgb_power_stats.requested_ma);
+    rgb_power_average += rgb_power_stats.current_ma - (rgb_power_average >> 6);
+    rgb_power_stats.average_ma = rgb_power_average >> 6;
+}
+#endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+
+#ifdef RGB_MATRIX_COMPOSITOR
+static void rgb_matrix_composite(uint8_t effect) {
+#    if RGB_MATRIX_OVERLAY_LAYERS > 0
+    // overlays are hidden along with the effect when the matrix is off or suspended
+    uint8_t visible = effect ? rgb_overlay_visible : 0;
+    if (visible != rgb_overlay_composited) {
+        rgb_overlay_composited = visible;
+        rgb_matrix_mark_all_dirty();
+    }
+#    endif // RGB_MATRIX_OVERLAY_LAYERS > 0
+#    if RGB_MATRIX_TRANSITION_MS > 0
+    uint16_t fade = 256;
+    if (rgb_transition_effect) {
+        uint32_t elapsed = g_rgb_timer - rgb_transition_start;
+        if (!effect || elapsed >= RGB_MATRIX_TRANSITION_MS) {
+            rgb_transition_effect = 0;
+        } else {
+            fade = elapsed * 256 / RGB_MATRIX_TRANSITION_MS;
+        }
+        // every LED changes while fading, and once more when the transition ends
+        rgb_matrix_mark_all_dirty();
+    }
+#    endif // RGB_MATRIX_TRANSITION_MS > 0
+#    ifdef RGB_MATRIX_DITHERING
+    // the dithered output of every LED can change from one frame to the next
+    rgb_matrix_mark_all_dirty();
+#    endif // RGB_MATRIX_DITHERING
+    if (!rgb_composite_pending) return;
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (!(rgb_composite_dirty[i / 8] & (1 << (i % 8)))) continue;
+
+        rgb_t out = rgb_effect_layer[i];
+#    if RGB_MATRIX_TRANSITION_MS > 0
+        if (fade < 256) {
+            out = rgb_matrix_blend(rgb_transition_layer[i], out, fade);
+        }
+#    endif // RGB_MATRIX_TRANSITION_MS > 0
+#    ifdef RGB_MATRIX_DITHERING
+        rgb_level_t level = rgb_matrix_lightness(out, rgb_dither_raw[i / 8] & (1 << (i % 8)));
+#    endif // RGB_MATRIX_DITHERING
+#    if RGB_MATRIX_OVERLAY_LAYERS > 0
+        for (uint8_t layer = 0; layer < RGB_MATRIX_OVERLAY_LAYERS; layer++) {
+            uint8_t alpha = rgb_overlay_alpha[layer][i];
+            if (!alpha || !(visible & (1 << layer))) continue;
+
+            rgb_t color = rgb_overlay_color[layer][i];
+#        ifdef RGB_MATRIX_DITHERING
+            // overlay colors are final as well
+            if (alpha == UINT8_MAX) {
+                level = rgb_matrix_lightness(color, true);
+            } else {
+                level.r = rgb_matrix_blend_level(level.r, color.r, alpha);
+                level.g = rgb_matrix_blend_level(level.g, color.g, alpha);
+                level.b = rgb_matrix_blend_level(level.b, color.b, alpha);
+            }
+#        else
+            if (alpha == UINT8_MAX) {
+                out = color;
+            } else {
+                out.r = blend8(out.r, color.r, alpha);
+                out.g = blend8(out.g, color.g, alpha);
+                out.b = blend8(out.b, color.b, alpha);
+            }
+#        endif // RGB_MATRIX_DITHERING
+        }
+#    endif // RGB_MATRIX_OVERLAY_LAYERS > 0
+#    ifdef RGB_MATRIX_DITHERING
+        out.r = rgb_matrix_dither(level.r, &rgb_dither_error[i][0]);
+        out.g = rgb_matrix_dither(level.g, &rgb_dither_error[i][1]);
+        out.b = rgb_matrix_dither(level.b, &rgb_dither_error[i][2]);
+#    endif // RGB_MATRIX_DITHERING
+#    if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+        rgb_t *prev = &rgb_output_layer[i];
+        rgb_output_level += (out.r + out.g + out.b) - (prev->r + prev->g + prev->b);
+        *prev = out;
+#    else
+        rgb_matrix_driver.set_color(rgb_matrix_led_index(i), out.r, out.g, out.b);
+#    endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+    }
+
+#    if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+    // the whole frame is known now, so it can be dimmed before any of it is sent
+    rgb_matrix_update_power();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (!(rgb_composite_dirty[i / 8] & (1 << (i % 8)))) continue;
+
+        rgb_t out = rgb_output_layer[i];
+        rgb_matrix_driver.set_color(rgb_matrix_led_index(i), out.r * rgb_output_scale >> 8, out.g * rgb_output_scale >> 8, out.b * rgb_output_scale >> 8);
+    }
+#    endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+    memset(rgb_composite_dirty, 0, sizeof(rgb_composite_dirty));
+    rgb_composite_pending = false;
+}
+#endif // RGB_MATRIX_COMPOSITOR
+
+static inline bool rgb_matrix_composite_pending(void) {
+#if defined(RGB_MATRIX_DITHERING)
+    // static effects keep flushing so the dithering can average out
+    return true;
+#elif defined(RGB_MATRIX_COMPOSITOR)
+    return rgb_composite_pending;
+#else
+    return false;
+#endif // RGB_MATRIX_COMPOSITOR
+}
+
+static inline uint8_t rgb_matrix_transition_effect(void) {
+#if RGB_MATRIX_TRANSITION_MS > 0
+    return rgb_transition_effect;
+#else
+    return 0;
+#endif // RGB_MATRIX_TRANSITION_MS > 0
+}
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_COMPOSITOR
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+
+    rgb_t *led = &rgb_render_target[index];
+    if (led->r != red || led->g != green || led->b != blue) {
+        *led = (rgb_t){.r = red, .g = green, .b = blue};
+        rgb_matrix_mark_dirty(index);
+    }
+#    ifdef RGB_MATRIX_DITHERING
+    if (rgb_render_target == rgb_effect_layer) {
+        rgb_matrix_dither_set_raw(index, !rgb_dither_rendering);
+    }
+#    endif // RGB_MATRIX_DITHERING
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif // RGB_MATRIX_COMPOSITOR
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_SPLIT) || defined(RGB_MATRIX_COMPOSITOR)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -178,11 +642,60 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// Hits are kept oldest first, so both overflowing and expired hits are removed from the front
+static void rgb_matrix_drop_hits(uint8_t count) {
+    uint8_t remaining = last_hit_buffer.count - count;
+    memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[count], remaining);
+    memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[count], remaining);
+    memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[count], remaining * sizeof(last_hit_buffer.tick[0]));
+    memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[count], remaining);
+    last_hit_buffer.count = remaining;
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#ifdef RGB_MATRIX_KEY_STATS
+static void rgb_matrix_count_key_press(uint8_t row, uint8_t col) {
+    if (rgb_matrix_key_stats[row][col] == UINT16_MAX) {
+        // halve every counter rather than saturate, so the ratios between keys are kept
+        for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+            for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                rgb_matrix_key_stats[i_row][i_col] >>= 1;
+            }
+        }
+    }
+    rgb_matrix_key_stats[row][col]++;
+    rgb_matrix_key_stats_dirty = true;
+}
+
+uint16_t rgb_matrix_get_key_presses(uint8_t row, uint8_t col) {
+    return row < MATRIX_ROWS && col < MATRIX_COLS ? rgb_matrix_key_stats[row][col] : 0;
+}
+
+void rgb_matrix_reset_key_stats(void) {
+    memset(rgb_matrix_key_stats, 0, sizeof(rgb_matrix_key_stats));
+    rgb_matrix_key_stats_dirty = true;
+}
+
+void rgb_matrix_save_key_stats(void) {
+    if (rgb_matrix_key_stats_dirty) {
+        eeconfig_update_rgb_matrix_key_stats(&rgb_matrix_key_stats[0][0]);
+        rgb_matrix_key_stats_dirty = false;
+    }
+}
+#endif // RGB_MATRIX_KEY_STATS
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
 
+#ifdef RGB_MATRIX_KEY_STATS
+    if (pressed) {
+        rgb_matrix_count_key_press(row, col);
+    }
+#endif // RGB_MATRIX_KEY_STATS
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     uint8_t led[LED_HITS_TO_REMEMBER];
     uint8_t led_count = 0;
@@ -197,11 +710,7 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
     }
 
     if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+        rgb_matrix_drop_hits(last_hit_buffer.count + led_count - LED_HITS_TO_REMEMBER);
     }
 
     for (uint8_t i = 0; i < led_count; i++) {
@@ -214,7 +723,7 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
-#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#ifdef ENABLE_RGB_MATRIX_TYPING_HEATMAP
 #    if defined(RGB_MATRIX_KEYRELEASES)
     if (!pressed)
 #    else
@@ -225,7 +734,7 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
             process_rgb_matrix_typing_heatmap(row, col);
         }
     }
-#endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#endif // ENABLE_RGB_MATRIX_TYPING_HEATMAP
 }
 
 void rgb_matrix_test(void) {
@@ -269,19 +778,39 @@ static void rgb_task_timers(void) {
 
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
+    uint8_t expired = 0;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
+        uint32_t tick           = MIN(last_hit_buffer.tick[i] + deltaTime, UINT16_MAX);
+        last_hit_buffer.tick[i] = tick;
+        if (tick == UINT16_MAX || scale16by8(tick, qadd8(rgb_matrix_config.speed, 1)) > LED_HITS_EXPIRE_TICK) {
+            expired = i + 1;
         }
-        last_hit_buffer.tick[i] += deltaTime;
+    }
+    if (expired) {
+        rgb_matrix_drop_hits(expired);
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
+static void rgb_task_stats(void) {
+    uint32_t elapsed = timer_elapsed32(rgb_render_stats_timer);
+    if (elapsed < 1000) return;
+
+    rgb_render_stats.fps            = (uint32_t)rgb_render_frames * 1000 / elapsed;
+    rgb_render_stats.worst_chunk_us = rgb_render_worst_us;
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+    rgb_render_stats.chunk_size = rgb_render_chunk;
+#else
+    rgb_render_stats.chunk_size = MIN(RGB_MATRIX_LED_PROCESS_LIMIT, RGB_MATRIX_LED_COUNT);
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+    rgb_render_stats_timer = timer_read32();
+    rgb_render_frames      = 0;
+    rgb_render_worst_us    = 0;
+}
+
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
+    rgb_task_stats();
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
@@ -292,9 +821,6 @@ static void rgb_task_start(void) {
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -307,66 +833,93 @@ static void rgb_task_start(void) {
     // Set effect to be renedered
     rgb_current_effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#if RGB_MATRIX_TRANSITION_MS > 0
+    // fade between effects on mode changes, but not when turning on, off or out of the test pattern
+    if (rgb_current_effect != rgb_last_effect && rgb_current_effect && rgb_last_effect && rgb_last_effect < RGB_MATRIX_EFFECT_MAX) {
+        rgb_matrix_transition_begin(rgb_last_effect);
+    }
+#endif // RGB_MATRIX_TRANSITION_MS > 0
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    // refreshed whatever the effect, as indicators and keyboard code may read it too
+    g_last_hit_tracker = last_hit_buffer;
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+#ifdef RGB_MATRIX_STATIC_RENDER_ONCE
+    // a static effect already on the LEDs only needs rendering again when the config changes
+    if ((rgb_matrix_get_effect_flags(rgb_current_effect) & RGB_MATRIX_EFFECT_STATIC) && !rgb_matrix_transition_effect() && rgb_current_effect == rgb_last_effect && rgb_matrix_config.raw == rgb_rendered_config) {
+        // overlay changes still need compositing and flushing
+        rgb_task_state = rgb_matrix_composite_pending() ? FLUSHING : SYNCING;
+        return;
+    }
+#endif // RGB_MATRIX_STATIC_RENDER_ONCE
+
     // next task
     rgb_task_state = RENDERING;
 }
 
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+static void rgb_task_render_limits(uint8_t iter) {
+#    if defined(RGB_MATRIX_SPLIT)
+    uint8_t first = is_keyboard_left() ? 0 : k_rgb_matrix_split[0];
+    uint8_t last  = is_keyboard_left() ? k_rgb_matrix_split[0] : RGB_MATRIX_LED_COUNT;
+#    else
+    uint8_t first = 0;
+    uint8_t last  = RGB_MATRIX_LED_COUNT;
+#    endif
+    rgb_render_limits.led_min_index = iter == 0 ? first : rgb_render_limits.led_max_index;
+    rgb_render_limits.led_max_index = MIN((uint16_t)rgb_render_limits.led_min_index + rgb_render_chunk, last);
+}
+
+static void rgb_task_render_adapt(uint32_t elapsed_us) {
+    uint8_t leds = rgb_render_limits.led_max_index - rgb_render_limits.led_min_index;
+    if (leds == 0) return;
+
+    // smooth the measured cost per LED, then size the next step to fit the budget
+    rgb_render_led_cost = (rgb_render_led_cost * 3 + (elapsed_us << 4) / leds) / 4;
+    uint32_t chunk      = ((uint32_t)RGB_MATRIX_RENDER_BUDGET_US << 4) / MAX(rgb_render_led_cost, 1);
+    rgb_render_chunk    = MAX(MIN(chunk, RGB_MATRIX_LED_COUNT), 1);
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+    rgb_task_render_limits(rgb_effect_params.iter);
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+    // Factory default magic value
+    if (effect == UINT8_MAX) {
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
+    }
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
-    switch (effect) {
-        case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
-#include "rgb_matrix_effects.inc"
-#undef RGB_MATRIX_EFFECT
-
-#ifdef COMMUNITY_MODULES_ENABLE
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_COMMUNITY_MODULE_##name:  \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    include "rgb_matrix_community_modules.inc"
-#    undef RGB_MATRIX_EFFECT
-#endif
-
-#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    ifdef RGB_MATRIX_CUSTOM_KB
-#        include "rgb_matrix_kb.inc"
-#    endif
-#    ifdef RGB_MATRIX_CUSTOM_USER
-#        include "rgb_matrix_user.inc"
-#    endif
-#    undef RGB_MATRIX_EFFECT
-#endif
-            // -----End rgb effect switch case macros-------
-            // ---------------------------------------------
-
-        // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+#ifdef RGB_MATRIX_DITHERING
+    // only effects render linear colors, everything else is sent as is
+    rgb_dither_rendering = true;
+#endif // RGB_MATRIX_DITHERING
+    rendering = rgb_matrix_render_effect(effect, &rgb_effect_params);
+#if RGB_MATRIX_TRANSITION_MS > 0
+    // the outgoing effect renders the same LEDs into its own buffer, so a transition doubles the
+    // cost of each step, RGB_MATRIX_RENDER_BUDGET_US shrinks the steps to compensate
+    if (rgb_transition_effect) {
+        rgb_transition_params.iter  = rgb_effect_params.iter;
+        rgb_transition_params.flags = rgb_effect_params.flags;
+        rgb_render_target           = rgb_transition_layer;
+        rendering |= rgb_matrix_render_effect(rgb_transition_effect, &rgb_transition_params);
+        rgb_render_target = rgb_effect_layer;
     }
+#endif // RGB_MATRIX_TRANSITION_MS > 0
+#ifdef RGB_MATRIX_DITHERING
+    rgb_dither_rendering = false;
+#endif // RGB_MATRIX_DITHERING
 
     rgb_effect_params.iter++;
 
@@ -384,6 +937,14 @@ static void rgb_task_flush(uint8_t effect) {
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
+    rgb_render_frames++;
+#ifdef RGB_MATRIX_STATIC_RENDER_ONCE
+    rgb_rendered_config = rgb_matrix_config.raw;
+#endif // RGB_MATRIX_STATIC_RENDER_ONCE
+
+#ifdef RGB_MATRIX_COMPOSITOR
+    rgb_matrix_composite(effect);
+#endif // RGB_MATRIX_COMPOSITOR
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
@@ -401,7 +962,8 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+            uint32_t render_start = RGB_RENDER_TIMESTAMP();
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -409,7 +971,12 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
-            break;
+            uint32_t elapsed_us = RGB_RENDER_ELAPSED_US(render_start);
+            rgb_render_worst_us = MAX(rgb_render_worst_us, MIN(elapsed_us, UINT16_MAX));
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+            rgb_task_render_adapt(elapsed_us);
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+        } break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -438,7 +1005,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+    // step sizes change at runtime, so these are always the limits of the step being rendered
+    limits = rgb_render_limits;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -489,6 +1059,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_update_geometry();
+#ifdef RGB_MATRIX_COMPOSITOR
+    rgb_matrix_mark_all_dirty();
+#endif // RGB_MATRIX_COMPOSITOR
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -508,9 +1082,18 @@ void rgb_matrix_init(void) {
         eeconfig_update_rgb_matrix_default();
     }
     eeconfig_debug_rgb_matrix(); // display current eeprom values
+
+#ifdef RGB_MATRIX_KEY_STATS
+    eeconfig_read_rgb_matrix_key_stats(&rgb_matrix_key_stats[0][0]);
+#endif // RGB_MATRIX_KEY_STATS
 }
 
 void rgb_matrix_set_suspend_state(bool state) {
+#ifdef RGB_MATRIX_KEY_STATS
+    if (state) {
+        rgb_matrix_save_key_stats(); // only writes when there were presses since the last save
+    }
+#endif // RGB_MATRIX_KEY_STATS
 #ifdef RGB_MATRIX_SLEEP
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
@@ -524,6 +1107,16 @@ bool rgb_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+rgb_matrix_render_stats_t rgb_matrix_get_render_stats(void) {
+    return rgb_render_stats;
+}
+
+#if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+rgb_matrix_power_stats_t rgb_matrix_get_power_stats(void) {
+    return rgb_power_stats;
+}
+#endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
     rgb_task_state = STARTING;
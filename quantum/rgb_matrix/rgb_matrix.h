@@ -82,6 +82,10 @@
 #    define RGB_MATRIX_DEFAULT_FLAGS LED_FLAG_ALL
 #endif
 
+#if !defined(RGB_MATRIX_LED_FLUSH_LIMIT) && defined(RGB_MATRIX_TARGET_FPS)
+#    define RGB_MATRIX_LED_FLUSH_LIMIT (1000 / RGB_MATRIX_TARGET_FPS)
+#endif
+
 #ifndef RGB_MATRIX_LED_FLUSH_LIMIT
 #    define RGB_MATRIX_LED_FLUSH_LIMIT 16
 #endif
@@ -90,6 +94,31 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+// When non-zero, the number of LEDs rendered per task run is adjusted at runtime to fit this many microseconds
+#ifndef RGB_MATRIX_RENDER_BUDGET_US
+#    define RGB_MATRIX_RENDER_BUDGET_US 0
+#endif
+
+// Number of overlay layers composited on top of the running effect, up to 8
+#ifndef RGB_MATRIX_OVERLAY_LAYERS
+#    define RGB_MATRIX_OVERLAY_LAYERS 0
+#endif
+
+// Duration of the cross-fade between effects when the mode changes, 0 switches instantly
+#ifndef RGB_MATRIX_TRANSITION_MS
+#    define RGB_MATRIX_TRANSITION_MS 0
+#endif
+
+// Estimated current the LEDs may draw, frames that would exceed it are dimmed, 0 disables the limiter
+#ifndef RGB_MATRIX_CURRENT_LIMIT_MA
+#    define RGB_MATRIX_CURRENT_LIMIT_MA 0
+#endif
+
+// Current drawn by a single color channel at full brightness
+#ifndef RGB_MATRIX_CHANNEL_CURRENT_MA
+#    define RGB_MATRIX_CHANNEL_CURRENT_MA 20
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -97,6 +126,38 @@ struct rgb_matrix_limits_t {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 
+typedef struct {
+    uint16_t fps;            // frames rendered during the last second
+    uint16_t worst_chunk_us; // slowest single render step during the last second
+    uint8_t  chunk_size;     // number of LEDs currently rendered per step
+} rgb_matrix_render_stats_t;
+
+rgb_matrix_render_stats_t rgb_matrix_get_render_stats(void);
+
+#if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+typedef struct {
+    uint16_t requested_ma; // estimated draw of the last frame before limiting
+    uint16_t current_ma;   // estimated draw of the last frame
+    uint16_t peak_ma;      // highest requested draw since startup
+    uint16_t average_ma;   // estimated draw averaged over the last 64 frames or so
+} rgb_matrix_power_stats_t;
+
+rgb_matrix_power_stats_t rgb_matrix_get_power_stats(void);
+#endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+
+#if RGB_MATRIX_OVERLAY_LAYERS > 0
+void rgb_matrix_overlay_set_color(uint8_t layer, uint8_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha);
+void rgb_matrix_overlay_clear(uint8_t layer);
+void rgb_matrix_overlay_set_visible(uint8_t layer, bool visible);
+bool rgb_matrix_overlay_is_visible(uint8_t layer);
+#endif // RGB_MATRIX_OVERLAY_LAYERS > 0
+
+#ifdef RGB_MATRIX_KEY_STATS
+uint16_t rgb_matrix_get_key_presses(uint8_t row, uint8_t col);
+void     rgb_matrix_reset_key_stats(void);
+void     rgb_matrix_save_key_stats(void);
+#endif // RGB_MATRIX_KEY_STATS
+
 #define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                   \
     struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(iter); \
     uint8_t                    min    = limits.led_min_index;        \
@@ -114,6 +175,11 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+// Effect metadata, given as the optional second argument of RGB_MATRIX_EFFECT()
+#define RGB_MATRIX_EFFECT_STATIC (1 << 0)      // output only depends on rgb_matrix_config
+#define RGB_MATRIX_EFFECT_FRAMEBUFFER (1 << 1) // uses g_rgb_frame_buffer
+#define RGB_MATRIX_EFFECT_KEYREACTIVE (1 << 2) // uses g_last_hit_tracker
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -148,6 +214,8 @@ enum rgb_matrix_effects {
 void eeconfig_update_rgb_matrix_default(void);
 void eeconfig_force_flush_rgb_matrix(void);
 
+uint8_t rgb_matrix_get_effect_flags(uint8_t mode);
+
 uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
 
@@ -171,6 +239,7 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+void rgb_matrix_update_geometry(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
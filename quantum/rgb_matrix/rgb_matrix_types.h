@@ -29,9 +29,18 @@
 
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
-#    define LED_HITS_TO_REMEMBER 8
+#    if defined(__AVR__)
+#        define LED_HITS_TO_REMEMBER 8
+#    else
+#        define LED_HITS_TO_REMEMBER 32
+#    endif
 #endif // LED_HITS_TO_REMEMBER
 
+// Hits older than this many effect ticks (milliseconds scaled by speed) no longer affect any core effect and are dropped
+#ifndef LED_HITS_EXPIRE_TICK
+#    define LED_HITS_EXPIRE_TICK 509
+#endif // LED_HITS_EXPIRE_TICK
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 typedef struct PACKED {
     uint8_t  count;
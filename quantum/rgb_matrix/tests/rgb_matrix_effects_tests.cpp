@@ -0,0 +1,649 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+#include "lib/lib8tion/lib8tion.h"
+}
+
+extern "C" {
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+extern const led_point_t k_rgb_matrix_center;
+hsv_t                    SOLID_SPLASH_math(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+}
+
+static rgb_t    led_buffer[RGB_MATRIX_LED_COUNT];
+static uint32_t flush_count;
+static uint32_t set_color_count;
+// simulated render cost, the mocked clock advances 1ms every this many LEDs
+static uint8_t  leds_per_ms;
+static uint8_t  leds_rendered;
+
+extern "C" {
+led_config_t g_led_config;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    led_buffer[index] = (rgb_t){r, g, b};
+    set_color_count++;
+    if (leds_per_ms && ++leds_rendered == leds_per_ms) {
+        leds_rendered = 0;
+        advance_time(1);
+    }
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        led_buffer[i] = (rgb_t){r, g, b};
+    }
+}
+
+static void mock_flush(void) {
+    flush_count++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+};
+
+static rgb_config_t eeprom_rgb_matrix_config;
+
+void eeconfig_read_rgb_matrix(rgb_config_t *rgb_matrix_config) {
+    *rgb_matrix_config = eeprom_rgb_matrix_config;
+}
+
+void eeconfig_update_rgb_matrix(const rgb_config_t *rgb_matrix_config) {
+    eeprom_rgb_matrix_config = *rgb_matrix_config;
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool is_keyboard_left(void) {
+    return true;
+}
+
+uint32_t last_input_activity_elapsed(void) {
+    return 0;
+}
+
+#ifdef RGB_MATRIX_KEY_STATS
+static uint16_t eeprom_key_stats[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t eeprom_key_stats_writes;
+
+void eeconfig_read_rgb_matrix_key_stats(uint16_t *counts) {
+    memcpy(counts, eeprom_key_stats, sizeof(eeprom_key_stats));
+}
+
+void eeconfig_update_rgb_matrix_key_stats(const uint16_t *counts) {
+    memcpy(eeprom_key_stats, counts, sizeof(eeprom_key_stats));
+    eeprom_key_stats_writes++;
+}
+#endif // RGB_MATRIX_KEY_STATS
+}
+
+class RgbMatrixEffects : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // One LED per key, spread over the full 224x64 coordinate space
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t i                         = row * MATRIX_COLS + col;
+                g_led_config.matrix_co[row][col] = i;
+                g_led_config.point[i]            = (led_point_t){(uint8_t)(col * 224 / (MATRIX_COLS - 1)), (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+                g_led_config.flags[i]            = LED_FLAG_KEYLIGHT;
+            }
+        }
+
+        set_time(0);
+        leds_per_ms                  = 0;
+        eeprom_rgb_matrix_config.raw = 0;
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        // resync the effect timers with the reset clock
+        rgb_matrix_task();
+    }
+
+    // Run the task state machine until the driver has been flushed once, or
+    // until a whole frame has passed without one
+    void render_frame() {
+        uint32_t flushes = flush_count;
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int step = 0; step < 4 + RGB_MATRIX_LED_COUNT && flush_count == flushes; step++) {
+            rgb_matrix_task();
+        }
+    }
+
+    // Switch effects, waiting for the cross-fade from the previous one to finish
+    void set_mode(uint8_t mode) {
+        rgb_matrix_mode_noeeprom(mode);
+#if RGB_MATRIX_TRANSITION_MS > 0
+        render_frame();
+        advance_time(RGB_MATRIX_TRANSITION_MS);
+        render_frame();
+#endif
+    }
+};
+
+// dithering changes the values sent to the driver from frame to frame
+#ifndef RGB_MATRIX_DITHERING
+TEST_F(RgbMatrixEffects, GeometryMatchesDirectComputation) {
+    set_mode(RGB_MATRIX_CYCLE_SPIRAL);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_set_speed_noeeprom(127);
+    render_frame();
+    render_frame();
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx       = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy       = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        hsv_t   hsv      = rgb_matrix_config.hsv;
+        hsv.h            = sqrt16(dx * dx + dy * dy) - time - atan2_8(dy, dx);
+        rgb_t   expected = hsv_to_rgb(hsv);
+        EXPECT_EQ(led_buffer[i].r, expected.r) << "LED " << (int)i;
+        EXPECT_EQ(led_buffer[i].g, expected.g) << "LED " << (int)i;
+        EXPECT_EQ(led_buffer[i].b, expected.b) << "LED " << (int)i;
+    }
+}
+#endif // RGB_MATRIX_DITHERING
+
+TEST_F(RgbMatrixEffects, EveryEffectRendersAndFlushes) {
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        set_mode(mode);
+        uint32_t flushes = flush_count;
+        render_frame();
+        render_frame();
+#ifdef RGB_MATRIX_STATIC_RENDER_ONCE
+        if (rgb_matrix_get_effect_flags(mode) & RGB_MATRIX_EFFECT_STATIC) {
+            EXPECT_EQ(flush_count, flushes + 1) << rgb_matrix_get_mode_name(mode);
+            continue;
+        }
+#endif // RGB_MATRIX_STATIC_RENDER_ONCE
+        EXPECT_EQ(flush_count, flushes + 2) << rgb_matrix_get_mode_name(mode);
+    }
+}
+
+TEST_F(RgbMatrixEffects, EffectTableHasMetadata) {
+    EXPECT_TRUE(rgb_matrix_get_effect_flags(RGB_MATRIX_NONE) & RGB_MATRIX_EFFECT_STATIC);
+    EXPECT_TRUE(rgb_matrix_get_effect_flags(RGB_MATRIX_SOLID_COLOR) & RGB_MATRIX_EFFECT_STATIC);
+    EXPECT_EQ(rgb_matrix_get_effect_flags(RGB_MATRIX_CYCLE_ALL), 0);
+    EXPECT_EQ(rgb_matrix_get_effect_flags(RGB_MATRIX_SPLASH), RGB_MATRIX_EFFECT_KEYREACTIVE);
+    EXPECT_EQ(rgb_matrix_get_effect_flags(RGB_MATRIX_DIGITAL_RAIN), RGB_MATRIX_EFFECT_FRAMEBUFFER);
+    EXPECT_EQ(rgb_matrix_get_effect_flags(RGB_MATRIX_EFFECT_MAX), 0);
+}
+
+TEST_F(RgbMatrixEffects, ExpiredHitsArePruned) {
+    set_mode(RGB_MATRIX_SOLID_MULTISPLASH);
+    rgb_matrix_set_speed_noeeprom(255);
+    for (uint8_t i = 0; i < 20; i++) {
+        rgb_matrix_handle_key_event(i % MATRIX_ROWS, i % MATRIX_COLS, true);
+    }
+    render_frame();
+    EXPECT_EQ(g_last_hit_tracker.count, MIN(20, LED_HITS_TO_REMEMBER));
+
+    // at full speed effect ticks are milliseconds
+    for (int frame = 0; frame * RGB_MATRIX_LED_FLUSH_LIMIT <= LED_HITS_EXPIRE_TICK + RGB_MATRIX_LED_FLUSH_LIMIT; frame++) {
+        render_frame();
+    }
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+}
+
+TEST_F(RgbMatrixEffects, HitTrackerRefreshedForAnyEffect) {
+    set_mode(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_handle_key_event(0, 0, true);
+    render_frame();
+    EXPECT_EQ(g_last_hit_tracker.count, 1);
+}
+
+#ifndef RGB_MATRIX_DITHERING
+TEST_F(RgbMatrixEffects, CulledSplashMatchesEveryHit) {
+    set_mode(RGB_MATRIX_SOLID_MULTISPLASH);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_set_speed_noeeprom(127);
+    for (int frame = 0; frame < 40; frame++) {
+        if (frame % 2 == 0) {
+            rgb_matrix_handle_key_event((frame * 7) % MATRIX_ROWS, (frame * 3) % MATRIX_COLS, true);
+        }
+        render_frame();
+
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            hsv_t hsv = rgb_matrix_config.hsv;
+            hsv.v     = 0;
+            for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+                int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+                hsv           = SOLID_SPLASH_math(hsv, dx, dy, sqrt16(dx * dx + dy * dy), tick);
+            }
+            hsv.v          = scale8(hsv.v, rgb_matrix_config.hsv.v);
+            rgb_t expected = hsv_to_rgb(hsv);
+            ASSERT_EQ(led_buffer[i].r, expected.r) << "frame " << frame << " LED " << (int)i;
+            ASSERT_EQ(led_buffer[i].g, expected.g) << "frame " << frame << " LED " << (int)i;
+            ASSERT_EQ(led_buffer[i].b, expected.b) << "frame " << frame << " LED " << (int)i;
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, HeatmapWarmsNeighborsAndCoolsDown) {
+    set_mode(RGB_MATRIX_TYPING_HEATMAP);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    render_frame();
+
+    rgb_matrix_handle_key_event(2, 7, true);
+    rgb_matrix_handle_key_event(2, 7, false);
+    render_frame();
+
+    // LEDs are 16 units apart, so the spread reaches two keys along each axis
+    auto heat = [](uint8_t val) {
+        hsv_t hsv = {(uint8_t)(170 - qsub8(val, 85)), 255, scale8((qadd8(170, val) - 170) * 3, 255)};
+        return hsv_to_rgb(hsv);
+    };
+    // the first decay step may already have passed
+    rgb_t pressed = led_buffer[g_led_config.matrix_co[2][7]];
+    EXPECT_TRUE(pressed.b == heat(32).b || pressed.b == heat(31).b);
+    rgb_t neighbor = led_buffer[g_led_config.matrix_co[2][8]];
+    EXPECT_TRUE(neighbor.b == heat(16).b || neighbor.b == heat(15).b);
+    EXPECT_GT(led_buffer[g_led_config.matrix_co[2][9]].b, 0);
+    EXPECT_EQ(led_buffer[g_led_config.matrix_co[2][10]].b, 0);
+    EXPECT_EQ(led_buffer[g_led_config.matrix_co[0][0]].b, 0);
+
+    advance_time(32 * 25); // default decrease delay
+    render_frame();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(led_buffer[i].r | led_buffer[i].g | led_buffer[i].b, 0) << "LED " << (int)i;
+    }
+}
+
+// a render budget may draw the whole first frame at once
+#    if RGB_MATRIX_RENDER_BUDGET_US == 0
+TEST_F(RgbMatrixEffects, HeatmapKeepsPressesDuringFirstFrame) {
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    render_frame();
+    set_mode(RGB_MATRIX_TYPING_HEATMAP);
+
+    // Press a key once the first LEDs of the first frame are rendered, before its own LED is
+    advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+    uint32_t rendered = set_color_count;
+    for (int step = 0; step < 4 && set_color_count == rendered; step++) {
+        rgb_matrix_task();
+    }
+    ASSERT_LT(set_color_count - rendered, (uint32_t)g_led_config.matrix_co[4][14]);
+    rgb_matrix_handle_key_event(4, 14, true);
+    rgb_matrix_handle_key_event(4, 14, false);
+
+    render_frame();
+    EXPECT_GT(led_buffer[g_led_config.matrix_co[4][14]].b, 0);
+}
+#    endif // RGB_MATRIX_RENDER_BUDGET_US == 0
+#endif // RGB_MATRIX_DITHERING
+
+#ifdef RGB_MATRIX_STATIC_RENDER_ONCE
+TEST_F(RgbMatrixEffects, StaticEffectRendersOnce) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    render_frame();
+
+    uint32_t flushes = flush_count;
+    for (int frame = 0; frame < 10; frame++) {
+        render_frame();
+    }
+    EXPECT_EQ(flush_count, flushes);
+
+    rgb_matrix_sethsv_noeeprom(85, 255, 255);
+    render_frame();
+    EXPECT_EQ(led_buffer[0].g, 255);
+}
+#endif // RGB_MATRIX_STATIC_RENDER_ONCE
+
+#if RGB_MATRIX_TRANSITION_MS > 0
+TEST_F(RgbMatrixEffects, TransitionCrossFades) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_set_speed_noeeprom(255);
+    render_frame();
+    rgb_t outgoing = hsv_to_rgb(rgb_matrix_config.hsv);
+
+    // each frame advances the effect clock by RGB_MATRIX_LED_FLUSH_LIMIT
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_GRADIENT_LEFT_RIGHT);
+    for (uint32_t elapsed = 0; elapsed < RGB_MATRIX_TRANSITION_MS + 2 * RGB_MATRIX_LED_FLUSH_LIMIT; elapsed += RGB_MATRIX_LED_FLUSH_LIMIT) {
+        render_frame();
+
+        uint16_t fade = MIN(elapsed * 256 / RGB_MATRIX_TRANSITION_MS, 256);
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            hsv_t hsv = rgb_matrix_config.hsv;
+            hsv.h += scale8(64, 255) * g_led_config.point[i].x >> 5;
+            rgb_t incoming = hsv_to_rgb(hsv);
+            ASSERT_EQ(led_buffer[i].r, (outgoing.r * (256 - fade) + incoming.r * fade) >> 8) << "elapsed " << elapsed << " LED " << (int)i;
+            ASSERT_EQ(led_buffer[i].g, (outgoing.g * (256 - fade) + incoming.g * fade) >> 8) << "elapsed " << elapsed << " LED " << (int)i;
+            ASSERT_EQ(led_buffer[i].b, (outgoing.b * (256 - fade) + incoming.b * fade) >> 8) << "elapsed " << elapsed << " LED " << (int)i;
+        }
+    }
+}
+
+TEST_F(RgbMatrixEffects, TransitionSkippedWhenTurningOn) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_disable_noeeprom();
+    render_frame();
+    EXPECT_EQ(led_buffer[0].r, 0);
+
+    rgb_matrix_enable_noeeprom();
+    render_frame();
+    EXPECT_EQ(led_buffer[0].r, 255);
+}
+#endif // RGB_MATRIX_TRANSITION_MS > 0
+
+#if RGB_MATRIX_OVERLAY_LAYERS > 0
+TEST_F(RgbMatrixEffects, OverlayBlendsOverEffect) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    rgb_matrix_overlay_clear(0);
+    rgb_matrix_overlay_set_color(0, 3, 0, 0, 255, 255);
+    rgb_matrix_overlay_set_color(0, 4, 0, 0, 255, 128);
+    rgb_matrix_overlay_set_visible(0, true);
+    render_frame();
+
+    EXPECT_EQ(led_buffer[3].r, 0);
+    EXPECT_EQ(led_buffer[3].b, 255);
+    EXPECT_EQ(led_buffer[4].r, blend8(255, 0, 128));
+    EXPECT_EQ(led_buffer[4].b, blend8(0, 255, 128));
+    EXPECT_EQ(led_buffer[5].r, 255);
+    EXPECT_EQ(led_buffer[5].b, 0);
+
+    rgb_matrix_overlay_set_visible(0, false);
+    render_frame();
+    EXPECT_EQ(led_buffer[3].r, 255);
+    EXPECT_EQ(led_buffer[3].b, 0);
+}
+
+TEST_F(RgbMatrixEffects, OnlyChangedLedsAreSent) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_overlay_clear(1);
+    rgb_matrix_overlay_set_visible(1, true);
+    render_frame();
+    render_frame();
+
+    set_color_count = 0;
+    rgb_matrix_overlay_set_color(1, 5, 0, 255, 0, 255);
+    render_frame();
+    EXPECT_EQ(set_color_count, 1);
+    EXPECT_EQ(led_buffer[5].g, 255);
+
+    set_color_count = 0;
+    render_frame();
+    EXPECT_EQ(set_color_count, 0);
+}
+
+TEST_F(RgbMatrixEffects, OverlaysHiddenWhenDisabled) {
+    set_mode(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_overlay_set_color(0, 7, 255, 255, 255, 255);
+    rgb_matrix_overlay_set_visible(0, true);
+    render_frame();
+    EXPECT_EQ(led_buffer[7].r, 255);
+
+    rgb_matrix_disable_noeeprom();
+    render_frame();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(led_buffer[i].r | led_buffer[i].g | led_buffer[i].b, 0) << "LED " << (int)i;
+    }
+}
+#endif // RGB_MATRIX_OVERLAY_LAYERS > 0
+
+#ifdef RGB_MATRIX_DITHERING
+// CIE 1931 lightness of an 8-bit value, in 8-bit PWM steps
+static double lightness(uint8_t value) {
+    double l = value * 100.0 / 255;
+    return (l <= 8 ? l / 903.3 : pow((l + 16) / 116, 3)) * 255;
+}
+
+TEST_F(RgbMatrixEffects, DitheringAveragesToLightness) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    for (uint8_t value : {8, 40, 100, 200}) {
+        rgb_matrix_sethsv_noeeprom(0, 0, value);
+        render_frame();
+
+        uint32_t sum = 0;
+        bool     levels[256] = {false};
+        for (int frame = 0; frame < 256; frame++) {
+            render_frame();
+            sum += led_buffer[0].r;
+            levels[led_buffer[0].r] = true;
+        }
+        EXPECT_NEAR(sum / 256.0, lightness(value), 2.0 / 256) << "value " << (int)value;
+        // only the two PWM steps around the target are ever sent
+        EXPECT_EQ(std::count(std::begin(levels), std::end(levels), true), 2) << "value " << (int)value;
+    }
+}
+
+TEST_F(RgbMatrixEffects, DitheringKeepsEndsExact) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 255);
+    for (int frame = 0; frame < 16; frame++) {
+        render_frame();
+        EXPECT_EQ(led_buffer[0].r, 255);
+    }
+    rgb_matrix_sethsv_noeeprom(0, 0, 0);
+    render_frame();
+    for (int frame = 0; frame < 16; frame++) {
+        render_frame();
+        EXPECT_EQ(led_buffer[0].r, 0);
+    }
+}
+
+TEST_F(RgbMatrixEffects, DitheringKeepsHue) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(21, 255, 128);
+    rgb_t color = hsv_to_rgb_nocie(rgb_matrix_config.hsv);
+    render_frame();
+
+    uint32_t sum_r = 0, sum_g = 0, sum_b = 0;
+    for (int frame = 0; frame < 256; frame++) {
+        render_frame();
+        sum_r += led_buffer[0].r;
+        sum_g += led_buffer[0].g;
+        sum_b += led_buffer[0].b;
+    }
+    // only the value follows the curve, the orange keeps its channel ratio
+    EXPECT_NEAR(sum_r / 256.0, lightness(color.r), 2.0 / 256);
+    EXPECT_NEAR((double)sum_g / sum_r, (double)color.g / color.r, 0.01);
+    EXPECT_EQ(sum_b, 0);
+}
+
+static bool  indicator_enabled = false;
+static rgb_t indicator_color;
+
+extern "C" bool rgb_matrix_indicators_user(void) {
+    if (indicator_enabled) {
+        rgb_matrix_set_color(0, indicator_color.r, indicator_color.g, indicator_color.b);
+    }
+    return true;
+}
+
+TEST_F(RgbMatrixEffects, DitheringSendsIndicatorsAsIs) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 128);
+    indicator_color   = (rgb_t){200, 100, 0};
+    indicator_enabled = true;
+    for (int frame = 0; frame < 16; frame++) {
+        render_frame();
+        EXPECT_EQ(led_buffer[0].r, 200);
+        EXPECT_EQ(led_buffer[0].g, 100);
+        EXPECT_EQ(led_buffer[0].b, 0);
+    }
+    indicator_enabled = false;
+
+    // the effect is curved again once the indicator is gone
+    uint32_t sum = 0;
+    render_frame();
+    for (int frame = 0; frame < 256; frame++) {
+        render_frame();
+        sum += led_buffer[0].r;
+    }
+    EXPECT_NEAR(sum / 256.0, lightness(128), 2.0 / 256);
+}
+#endif // RGB_MATRIX_DITHERING
+
+#if RGB_MATRIX_CURRENT_LIMIT_MA > 0
+static uint32_t estimated_current_ma(void) {
+    uint32_t level = 0;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        level += led_buffer[i].r + led_buffer[i].g + led_buffer[i].b;
+    }
+    return level * RGB_MATRIX_CHANNEL_CURRENT_MA / 255;
+}
+
+TEST_F(RgbMatrixEffects, CurrentLimitDimsWholeFrame) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 255);
+    render_frame();
+
+    rgb_matrix_power_stats_t stats = rgb_matrix_get_power_stats();
+    EXPECT_EQ(stats.requested_ma, RGB_MATRIX_LED_COUNT * 3 * RGB_MATRIX_CHANNEL_CURRENT_MA);
+    EXPECT_EQ(stats.peak_ma, stats.requested_ma);
+    EXPECT_LE(stats.current_ma, RGB_MATRIX_CURRENT_LIMIT_MA);
+    EXPECT_LE(estimated_current_ma(), RGB_MATRIX_CURRENT_LIMIT_MA);
+    EXPECT_GT(estimated_current_ma(), RGB_MATRIX_CURRENT_LIMIT_MA * 9 / 10);
+    for (uint8_t i = 1; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(led_buffer[i].r, led_buffer[0].r) << "LED " << (int)i;
+    }
+
+    // back under budget, the full colors come back
+    rgb_matrix_sethsv_noeeprom(0, 255, 20);
+    render_frame();
+    EXPECT_EQ(led_buffer[0].r, 20);
+    EXPECT_EQ(led_buffer[RGB_MATRIX_LED_COUNT - 1].r, 20);
+    EXPECT_EQ(rgb_matrix_get_power_stats().peak_ma, stats.peak_ma);
+}
+
+TEST_F(RgbMatrixEffects, CurrentEstimateTracksChangingLeds) {
+    set_mode(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    rgb_matrix_sethsv_noeeprom(0, 255, 30);
+    rgb_matrix_set_speed_noeeprom(255);
+    for (int frame = 0; frame < 50; frame++) {
+        render_frame();
+        // under budget nothing is dimmed, so the driver holds the requested frame
+        EXPECT_EQ(rgb_matrix_get_power_stats().requested_ma, estimated_current_ma()) << "frame " << frame;
+    }
+}
+#endif // RGB_MATRIX_CURRENT_LIMIT_MA > 0
+
+#ifdef RGB_MATRIX_KEY_STATS
+TEST_F(RgbMatrixEffects, KeyStatsPersistOnSuspend) {
+    rgb_matrix_reset_key_stats();
+    for (uint8_t i = 0; i < 10; i++) {
+        rgb_matrix_handle_key_event(1, 3, true);
+        rgb_matrix_handle_key_event(1, 3, false);
+    }
+    rgb_matrix_handle_key_event(4, 14, true);
+    EXPECT_EQ(rgb_matrix_get_key_presses(1, 3), 10);
+    EXPECT_EQ(rgb_matrix_get_key_presses(4, 14), 1);
+    EXPECT_EQ(rgb_matrix_get_key_presses(0, 0), 0);
+
+    uint32_t writes = eeprom_key_stats_writes;
+    rgb_matrix_set_suspend_state(true);
+    rgb_matrix_set_suspend_state(true);
+    rgb_matrix_set_suspend_state(false);
+    EXPECT_EQ(eeprom_key_stats_writes, writes + 1);
+    EXPECT_EQ(eeprom_key_stats[1][3], 10);
+
+    rgb_matrix_reset_key_stats();
+    EXPECT_EQ(rgb_matrix_get_key_presses(1, 3), 0);
+    rgb_matrix_init();
+    EXPECT_EQ(rgb_matrix_get_key_presses(1, 3), 10);
+}
+
+TEST_F(RgbMatrixEffects, KeyStatsKeepRatiosWhenFull) {
+    rgb_matrix_reset_key_stats();
+    for (uint32_t i = 0; i < UINT16_MAX; i++) {
+        rgb_matrix_handle_key_event(0, 0, true);
+    }
+    for (uint8_t i = 0; i < 100; i++) {
+        rgb_matrix_handle_key_event(0, 1, true);
+    }
+    rgb_matrix_handle_key_event(0, 0, true);
+    EXPECT_EQ(rgb_matrix_get_key_presses(0, 0), UINT16_MAX / 2 + 1);
+    EXPECT_EQ(rgb_matrix_get_key_presses(0, 1), 50);
+}
+#endif // RGB_MATRIX_KEY_STATS
+
+#ifdef RGB_MATRIX_EFFECTS_BENCHMARK
+#    define BENCHMARK_FRAMES 500
+
+// Not a pass/fail test: reports the average render cost of a frame for every
+// effect so runs with and without RGB_MATRIX_GEOMETRY_CACHE can be compared.
+TEST_F(RgbMatrixEffects, FrameRenderCost) {
+#    ifdef RGB_MATRIX_GEOMETRY_CACHE
+    printf("frame render cost, geometry cache enabled\n");
+#    else
+    printf("frame render cost, geometry cache disabled\n");
+#    endif
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        set_mode(mode);
+        render_frame();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+            // keep the reactive effects and the heatmap busy
+            if (frame % 8 == 0) {
+                rgb_matrix_handle_key_event(frame % MATRIX_ROWS, frame % MATRIX_COLS, true);
+                rgb_matrix_handle_key_event(frame % MATRIX_ROWS, frame % MATRIX_COLS, false);
+            }
+            render_frame();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        printf("%-32s %8.2f us/frame\n", rgb_matrix_get_mode_name(mode), elapsed.count() / 1000.0 / BENCHMARK_FRAMES);
+    }
+}
+#endif // RGB_MATRIX_EFFECTS_BENCHMARK
+
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+TEST_F(RgbMatrixEffects, RenderStepFitsBudget) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    leds_per_ms = 5; // 200us per LED
+
+    for (int frame = 0; frame < 100; frame++) {
+        render_frame();
+    }
+    advance_time(1000);
+    rgb_matrix_task();
+
+    rgb_matrix_render_stats_t stats = rgb_matrix_get_render_stats();
+    EXPECT_EQ(stats.chunk_size, RGB_MATRIX_RENDER_BUDGET_US / 200);
+    EXPECT_GT(stats.fps, 0);
+    EXPECT_LE(stats.worst_chunk_us, 2 * RGB_MATRIX_RENDER_BUDGET_US);
+}
+
+TEST_F(RgbMatrixEffects, RenderStepsCoverEveryLed) {
+    set_mode(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    leds_per_ms = 5;
+    for (int frame = 0; frame < 20; frame++) {
+        render_frame();
+    }
+
+    memset(led_buffer, 0, sizeof(led_buffer));
+    render_frame();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(led_buffer[i].r, 255) << "LED " << (int)i;
+    }
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
@@ -0,0 +1,73 @@
+RGB_MATRIX_TEST_DEFS := -DMATRIX_ROWS=5 -DMATRIX_COLS=15 -DRGB_MATRIX_LED_COUNT=75 -DRGB_MATRIX_ENABLE -DNO_DEBUG -DNO_PRINT
+
+RGB_MATRIX_TEST_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+
+RGB_MATRIX_TEST_INC := \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(QUANTUM_PATH)/rgb_matrix/animations/runners
+
+RGB_MATRIX_TEST_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_effects_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix.c \
+	$(QUANTUM_PATH)/color.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+rgb_matrix_effects_DEFS := $(RGB_MATRIX_TEST_DEFS)
+rgb_matrix_effects_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_geometry_cache_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_GEOMETRY_CACHE -DRGB_MATRIX_TYPING_HEATMAP_NEIGHBORS=16
+rgb_matrix_effects_geometry_cache_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_geometry_cache_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_geometry_cache_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_benchmark_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_EFFECTS_BENCHMARK
+rgb_matrix_effects_benchmark_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_benchmark_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_benchmark_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_geometry_cache_benchmark_DEFS := $(rgb_matrix_effects_geometry_cache_DEFS) -DRGB_MATRIX_EFFECTS_BENCHMARK
+rgb_matrix_effects_geometry_cache_benchmark_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_geometry_cache_benchmark_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_geometry_cache_benchmark_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_render_budget_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_RENDER_BUDGET_US=4000
+rgb_matrix_effects_render_budget_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_render_budget_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_render_budget_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_key_stats_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_KEY_STATS
+rgb_matrix_effects_key_stats_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_key_stats_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_key_stats_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_static_render_once_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_STATIC_RENDER_ONCE
+rgb_matrix_effects_static_render_once_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_static_render_once_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_static_render_once_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_compositor_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_OVERLAY_LAYERS=2 -DRGB_MATRIX_STATIC_RENDER_ONCE
+rgb_matrix_effects_compositor_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_compositor_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_compositor_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_transition_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_TRANSITION_MS=256
+rgb_matrix_effects_transition_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_transition_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_transition_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_dithering_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_DITHERING
+rgb_matrix_effects_dithering_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_dithering_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_dithering_SRC := $(RGB_MATRIX_TEST_SRC)
+
+rgb_matrix_effects_current_limit_DEFS := $(RGB_MATRIX_TEST_DEFS) -DRGB_MATRIX_CURRENT_LIMIT_MA=200 -DRGB_MATRIX_CHANNEL_CURRENT_MA=1
+rgb_matrix_effects_current_limit_CONFIG := $(RGB_MATRIX_TEST_CONFIG)
+rgb_matrix_effects_current_limit_INC := $(RGB_MATRIX_TEST_INC)
+rgb_matrix_effects_current_limit_SRC := $(RGB_MATRIX_TEST_SRC)
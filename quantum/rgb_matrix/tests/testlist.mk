@@ -0,0 +1,12 @@
+TEST_LIST += \
+	rgb_matrix_effects \
+	rgb_matrix_effects_geometry_cache \
+	rgb_matrix_effects_benchmark \
+	rgb_matrix_effects_geometry_cache_benchmark \
+	rgb_matrix_effects_render_budget \
+	rgb_matrix_effects_key_stats \
+	rgb_matrix_effects_static_render_once \
+	rgb_matrix_effects_compositor \
+	rgb_matrix_effects_transition \
+	rgb_matrix_effects_dithering \
+	rgb_matrix_effects_current_limit
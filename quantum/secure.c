@@ -4,6 +4,7 @@
 #include "secure.h"
 #include "timer.h"
 #include "util.h"
+#include "deadline.h"
 
 #ifndef SECURE_UNLOCK_TIMEOUT
 #    define SECURE_UNLOCK_TIMEOUT 5000
@@ -21,6 +22,22 @@ static secure_status_t secure_status = SECURE_LOCKED;
 static uint32_t        unlock_time   = 0;
 static uint32_t        idle_time     = 0;
 
+static void secure_schedule_timeout(void) {
+#if SECURE_UNLOCK_TIMEOUT != 0
+    if (secure_status == SECURE_PENDING) {
+        deadline_set(DEADLINE_SECURE, unlock_time + SECURE_UNLOCK_TIMEOUT, secure_task);
+        return;
+    }
+#endif
+#if SECURE_IDLE_TIMEOUT != 0
+    if (secure_status == SECURE_UNLOCKED) {
+        deadline_set(DEADLINE_SECURE, idle_time + SECURE_IDLE_TIMEOUT, secure_task);
+        return;
+    }
+#endif
+    deadline_cancel(DEADLINE_SECURE);
+}
+
 static void secure_hook(secure_status_t secure_status) {
     secure_hook_quantum(secure_status);
     secure_hook_kb(secure_status);
@@ -32,12 +49,14 @@ secure_status_t secure_get_status(void) {
 
 void secure_lock(void) {
     secure_status = SECURE_LOCKED;
+    secure_schedule_timeout();
     secure_hook(secure_status);
 }
 
 void secure_unlock(void) {
     secure_status = SECURE_UNLOCKED;
     idle_time     = timer_read32();
+    secure_schedule_timeout();
     secure_hook(secure_status);
 }
 
@@ -45,6 +64,7 @@ void secure_request_unlock(void) {
     if (secure_status == SECURE_LOCKED) {
         secure_status = SECURE_PENDING;
         unlock_time   = timer_read32();
+        secure_schedule_timeout();
     }
     secure_hook(secure_status);
 }
@@ -52,6 +72,7 @@ void secure_request_unlock(void) {
 void secure_activity_event(void) {
     if (secure_status == SECURE_UNLOCKED) {
         idle_time = timer_read32();
+        secure_schedule_timeout();
     }
 }
 
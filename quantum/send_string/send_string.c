@@ -22,8 +22,18 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
+#include "host.h"
+#include "keycode_config.h"
 #include "wait.h"
 
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+#    include "timer.h"
+#    ifdef UNICODE_COMMON_ENABLE
+#        include "unicode.h"
+#    endif
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -150,43 +160,52 @@ void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
-void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
-    while (1) {
-        char ascii_code = getter(arg);
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
+// Sends the escape sequence following SS_QMK_PREFIX, returns false if it ended the string
+static bool send_string_escape(char (*getter)(void *), void *arg, uint8_t interval) {
+    char ascii_code = getter(arg);
+
+    if (ascii_code == SS_TAP_CODE) {
+        // tap
+        uint8_t keycode = getter(arg);
+        tap_code(keycode);
+    } else if (ascii_code == SS_DOWN_CODE) {
+        // down
+        uint8_t keycode = getter(arg);
+        register_code(keycode);
+    } else if (ascii_code == SS_UP_CODE) {
+        // up
+        uint8_t keycode = getter(arg);
+        unregister_code(keycode);
+    } else if (ascii_code == SS_DELAY_CODE) {
+        // delay
+        int ms     = 0;
+        ascii_code = getter(arg);
+
+        while (isdigit(ascii_code)) {
+            ms *= 10;
+            ms += ascii_code - '0';
             ascii_code = getter(arg);
+        }
 
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = getter(arg);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = getter(arg);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = getter(arg);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int ms     = 0;
-                ascii_code = getter(arg);
-
-                while (isdigit(ascii_code)) {
-                    ms *= 10;
-                    ms += ascii_code - '0';
-                    ascii_code = getter(arg);
-                }
+        wait_ms(ms);
+    }
 
-                wait_ms(ms);
-            }
+    wait_ms(interval);
 
-            wait_ms(interval);
+    // if we had a delay that terminated with a null, we're done
+    return ascii_code != 0;
+}
 
-            // if we had a delay that terminated with a null, we're done
-            if (ascii_code == 0) break;
+void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+    // anything already queued has to be typed first
+    send_string_async_flush();
+#endif
+    while (1) {
+        char ascii_code = getter(arg);
+        if (!ascii_code) break;
+        if (ascii_code == SS_QMK_PREFIX) {
+            if (!send_string_escape(getter, arg, interval)) break;
         } else {
             send_char_with_delay(ascii_code, interval);
         }
@@ -209,6 +228,314 @@ void send_string_with_delay(const char *string, uint8_t interval) {
     send_string_with_delay_impl(send_string_get_next_ram, &state, interval);
 }
 
+#ifndef SEND_STRING_PACKED_MAX_KEYS
+#    define SEND_STRING_PACKED_MAX_KEYS 8
+#endif
+
+typedef struct {
+    uint8_t held[SEND_STRING_PACKED_MAX_KEYS]; // keys down in the last report
+    uint8_t next[SEND_STRING_PACKED_MAX_KEYS]; // keys to press in the next report, in ascending order
+    uint8_t held_count;
+    uint8_t next_count;
+    uint8_t limit;
+    uint8_t mods;
+    uint8_t interval;
+} send_string_packed_state_t;
+
+static bool send_string_packed_is_held(const send_string_packed_state_t *state, uint8_t keycode) {
+    for (uint8_t i = 0; i < state->held_count; i++) {
+        if (state->held[i] == keycode) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Releases the keys of the last report and presses the next ones in a single report
+static void send_string_packed_send(send_string_packed_state_t *state) {
+    for (uint8_t i = 0; i < state->held_count; i++) {
+        del_key(state->held[i]);
+    }
+    for (uint8_t i = 0; i < state->next_count; i++) {
+        add_key(state->next[i]);
+        state->held[i] = state->next[i];
+    }
+    state->held_count = state->next_count;
+    state->next_count = 0;
+    send_keyboard_report();
+    wait_ms(state->interval);
+}
+
+// Releases every key, then switches to the given modifiers in the same report
+static void send_string_packed_release(send_string_packed_state_t *state, uint8_t mods) {
+    if (state->next_count) {
+        send_string_packed_send(state);
+    }
+    if (!state->held_count && state->mods == mods) {
+        return;
+    }
+    for (uint8_t i = 0; i < state->held_count; i++) {
+        del_key(state->held[i]);
+    }
+    state->held_count = 0;
+    del_mods(state->mods & ~mods);
+    add_mods(mods & ~state->mods);
+    state->mods = mods;
+    send_keyboard_report();
+    wait_ms(state->interval);
+}
+
+static void send_string_packed_add(send_string_packed_state_t *state, uint8_t keycode) {
+    // The host is only guaranteed to see keys pressed in the same report in ascending order, and a
+    // key still down from the last report has to be released before it can be pressed again
+    if (state->next_count && (keycode <= state->next[state->next_count - 1] || state->next_count == state->limit || send_string_packed_is_held(state, keycode))) {
+        send_string_packed_send(state);
+    }
+    if (send_string_packed_is_held(state, keycode)) {
+        send_string_packed_release(state, state->mods);
+    }
+    state->next[state->next_count++] = keycode;
+}
+
+void send_string_packed_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+    send_string_async_flush();
+#endif
+    send_string_packed_state_t state = {.limit = 1, .interval = interval};
+#ifdef NKRO_ENABLE
+    if (host_can_send_nkro() && keymap_config.nkro) {
+        state.limit = SEND_STRING_PACKED_MAX_KEYS;
+    }
+#endif
+
+    while (1) {
+        char ascii_code = getter(arg);
+        if (!ascii_code) break;
+
+        uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+        bool    is_dead = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+        if (ascii_code == SS_QMK_PREFIX || is_dead || ascii_code == '\a') {
+            // escapes, dead keys and the bell go through the regular path
+            send_string_packed_release(&state, 0);
+            if (ascii_code == SS_QMK_PREFIX) {
+                if (!send_string_escape(getter, arg, interval)) break;
+            } else {
+                send_char_with_delay(ascii_code, interval);
+            }
+            continue;
+        }
+        if (keycode == KC_NO) {
+            continue;
+        }
+
+        uint8_t mods = (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+        if (mods != state.mods) {
+            send_string_packed_release(&state, mods);
+        }
+        send_string_packed_add(&state, keycode);
+    }
+
+    send_string_packed_release(&state, 0);
+}
+
+void send_string_packed(const char *string) {
+    send_string_memory_state_t state = {string};
+    send_string_packed_impl(send_string_get_next_ram, &state, TAP_CODE_DELAY);
+}
+
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+#    ifndef SEND_STRING_ASYNC_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define SEND_STRING_ASYNC_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define SEND_STRING_ASYNC_INTERVAL 1
+#        endif
+#    endif
+
+#    define SEND_STRING_ASYNC_SHIFT 0x01
+#    define SEND_STRING_ASYNC_ALTGR 0x02
+
+// Queued strings are kept NUL separated, `head == tail` means the queue is empty
+static char     send_string_queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint16_t send_string_queue_head;
+static uint16_t send_string_queue_tail;
+
+static uint16_t send_string_async_timer;
+static uint16_t send_string_async_wait;
+static uint8_t  send_string_async_release;
+static uint8_t  send_string_async_mods;
+static bool     send_string_async_dead;
+
+static inline uint16_t send_string_queue_next(uint16_t index) {
+    return index + 1 < SEND_STRING_ASYNC_QUEUE_SIZE ? index + 1 : 0;
+}
+
+static inline bool send_string_queue_empty(void) {
+    return send_string_queue_head == send_string_queue_tail;
+}
+
+static char send_string_queue_peek(void) {
+    return send_string_queue_empty() ? 0 : send_string_queue[send_string_queue_head];
+}
+
+static char send_string_queue_pop(void) {
+    if (send_string_queue_empty()) {
+        return 0;
+    }
+    char ret               = send_string_queue[send_string_queue_head];
+    send_string_queue_head = send_string_queue_next(send_string_queue_head);
+    return ret;
+}
+
+bool send_string_async_impl(char (*getter)(void *), void *arg) {
+    // the tail is only published once the whole string fits, so a partial string is never typed
+    uint16_t tail = send_string_queue_tail;
+    while (1) {
+        uint16_t next = send_string_queue_next(tail);
+        if (next == send_string_queue_head) {
+            return false;
+        }
+        char ascii_code         = getter(arg);
+        send_string_queue[tail] = ascii_code;
+        tail                    = next;
+        if (!ascii_code) break;
+    }
+    send_string_queue_tail = tail;
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_impl(send_string_get_next_ram, &state);
+}
+
+bool send_string_async_busy(void) {
+    return !send_string_queue_empty() || send_string_async_release || send_string_async_dead || send_string_async_mods;
+}
+
+// Modifiers the next queued character has to be typed with, escapes are sent without any
+static uint8_t send_string_async_next_mods(void) {
+    uint8_t ascii_code = send_string_queue_peek();
+    if (ascii_code == 0 || ascii_code == SS_QMK_PREFIX || ascii_code >= 128) {
+        return 0;
+    }
+    return (PGM_LOADBIT(ascii_to_shift_lut, ascii_code) ? SEND_STRING_ASYNC_SHIFT : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, ascii_code) ? SEND_STRING_ASYNC_ALTGR : 0);
+}
+
+// Changes at most one key, so every step is a single report. Returns the time to wait before the next step.
+static uint16_t send_string_async_step(void) {
+    if (send_string_async_release) {
+        unregister_code(send_string_async_release);
+        send_string_async_release = 0;
+        return SEND_STRING_ASYNC_INTERVAL;
+    }
+
+    // skip separators so a run of shifted characters can continue into the next string
+    while (!send_string_queue_empty() && !send_string_queue_peek()) {
+        send_string_queue_pop();
+    }
+
+    // the space after a dead key is sent without modifiers
+    uint8_t mods = send_string_async_dead ? 0 : send_string_async_next_mods();
+    if (send_string_async_mods != mods) {
+        // same order as send_char_with_delay(): press Shift before AltGr, release AltGr before Shift
+        uint8_t released = send_string_async_mods & ~mods;
+        uint8_t pressed  = mods & ~send_string_async_mods;
+        if (released & SEND_STRING_ASYNC_ALTGR) {
+            unregister_code(KC_RIGHT_ALT);
+            send_string_async_mods &= ~SEND_STRING_ASYNC_ALTGR;
+        } else if (released & SEND_STRING_ASYNC_SHIFT) {
+            unregister_code(KC_LEFT_SHIFT);
+            send_string_async_mods &= ~SEND_STRING_ASYNC_SHIFT;
+        } else if (pressed & SEND_STRING_ASYNC_SHIFT) {
+            register_code(KC_LEFT_SHIFT);
+            send_string_async_mods |= SEND_STRING_ASYNC_SHIFT;
+        } else {
+            register_code(KC_RIGHT_ALT);
+            send_string_async_mods |= SEND_STRING_ASYNC_ALTGR;
+        }
+        return SEND_STRING_ASYNC_INTERVAL;
+    }
+
+    if (send_string_async_dead) {
+        send_string_async_dead = false;
+        register_code(KC_SPACE);
+        send_string_async_release = KC_SPACE;
+        return SEND_STRING_ASYNC_INTERVAL;
+    }
+
+    while (!send_string_queue_empty()) {
+        char ascii_code = send_string_queue_pop();
+        if (ascii_code == SS_QMK_PREFIX) {
+            ascii_code = send_string_queue_pop();
+
+            if (ascii_code == SS_TAP_CODE) {
+                uint8_t keycode = send_string_queue_pop();
+                register_code(keycode);
+                send_string_async_release = keycode;
+            } else if (ascii_code == SS_DOWN_CODE) {
+                register_code(send_string_queue_pop());
+            } else if (ascii_code == SS_UP_CODE) {
+                unregister_code(send_string_queue_pop());
+            } else if (ascii_code == SS_DELAY_CODE) {
+                uint16_t ms = 0;
+                ascii_code  = send_string_queue_pop();
+
+                while (isdigit(ascii_code)) {
+                    ms *= 10;
+                    ms += ascii_code - '0';
+                    ascii_code = send_string_queue_pop();
+                }
+
+                return ms;
+            } else if (ascii_code == SS_UNICODE_CODE) {
+                uint32_t code_point = 0;
+                for (uint8_t i = 0; i < 3; i++) {
+                    code_point = (code_point << 7) | (send_string_queue_pop() & 0x7F);
+                }
+#    ifdef UNICODE_COMMON_ENABLE
+                register_unicode(code_point);
+#    endif
+            } else if (!ascii_code) {
+                // truncated escape at the end of a string
+                continue;
+            }
+            return SEND_STRING_ASYNC_INTERVAL;
+        }
+
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        if (ascii_code == '\a') {
+            send_char_with_delay(ascii_code, 0);
+            return SEND_STRING_ASYNC_INTERVAL;
+        }
+#    endif
+
+        uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+        register_code(keycode);
+        send_string_async_release = keycode;
+        send_string_async_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+        return SEND_STRING_ASYNC_INTERVAL;
+    }
+
+    return 0;
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_busy()) {
+        wait_ms(send_string_async_step());
+    }
+    send_string_async_wait = 0;
+}
+
+void send_string_task(void) {
+    if (!send_string_async_busy() || timer_elapsed(send_string_async_timer) < send_string_async_wait) {
+        return;
+    }
+    send_string_async_wait  = send_string_async_step();
+    send_string_async_timer = timer_read();
+}
+#endif
+
 void send_char(char ascii_code) {
     send_char_with_delay(ascii_code, TAP_CODE_DELAY);
 }
@@ -329,4 +656,16 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     send_string_memory_state_t state = {string};
     send_string_with_delay_impl(send_string_get_next_progmem, &state, interval);
 }
+
+void send_string_packed_P(const char *string) {
+    send_string_memory_state_t state = {string};
+    send_string_packed_impl(send_string_get_next_progmem, &state, TAP_CODE_DELAY);
+}
+
+#    ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+bool send_string_async_P(const char *string) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_impl(send_string_get_next_progmem, &state);
+}
+#    endif
 #endif
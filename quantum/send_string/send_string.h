@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -169,4 +170,94 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 
+/**
+ * \brief Type out a string of ASCII characters using as few reports as possible.
+ *
+ * Each report releases the keys of the previous one while pressing the next. When NKRO is in use, runs of characters
+ * with ascending keycodes and the same modifiers are also pressed together in a single report, which hosts process in
+ * keycode order. Escapes, dead keys and `\a` are sent the same way as `send_string()`.
+ *
+ * \param string The string to type out.
+ */
+void send_string_packed(const char *string);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters using as few reports as possible.
+ *
+ * On ARM devices, this function is simply an alias for send_string_packed(string).
+ *
+ * \param string The string to type out.
+ */
+void send_string_packed_P(const char *string);
+#else
+#    define send_string_packed_P(string) send_string_packed(string)
+#endif
+
+/**
+ * \brief Shortcut macro for send_string_packed_P(PSTR(string)).
+ */
+#define SEND_STRING_PACKED(string) send_string_packed_P(PSTR(string))
+
+/**
+ * \brief Packed counterpart of `send_string_with_delay_impl()`, see `send_string_packed()`.
+ */
+void send_string_packed_impl(char (*getter)(void *), void *arg, uint8_t interval);
+
+#if defined(SEND_STRING_ASYNC_QUEUE_SIZE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop.
+ *
+ * The string is sent one report at a time by `send_string_task()`, so matrix scanning and the other tasks keep running
+ * while it drains. Consecutive characters that need the same modifiers share a single Shift/AltGr press.
+ *
+ * \param string The string to type out.
+ *
+ * \return `false` if the queue does not have room for the whole string, in which case nothing is queued.
+ */
+bool send_string_async(const char *string);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async(string).
+ *
+ * \param string The string to type out.
+ *
+ * \return `false` if the queue does not have room for the whole string, in which case nothing is queued.
+ */
+bool send_string_async_P(const char *string);
+#    else
+#        define send_string_async_P(string) send_string_async(string)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string)).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_P(PSTR(string))
+
+/**
+ * \brief Queue the string returned by the getter function, see `send_string_with_delay_impl()`.
+ *
+ * \return `false` if the queue does not have room for the whole string, in which case nothing is queued.
+ */
+bool send_string_async_impl(char (*getter)(void *), void *arg);
+
+/**
+ * \brief Whether the queue still has keys to send or release.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Send everything left in the queue, blocking until it is empty.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Send the next report from the queue, called from the main loop.
+ */
+void send_string_task(void);
+#endif
+
 /** \} */
@@ -420,6 +420,8 @@
 #define SS_DOWN_CODE 2
 #define SS_UP_CODE 3
 #define SS_DELAY_CODE 4
+// Only understood by the send_string queue, followed by the code point as three 7-bit groups with the top bit set
+#define SS_UNICODE_CODE 5
 
 #define SS_TAP(keycode) "\1\1" SYMBOL_STR(keycode)
 #define SS_DOWN(keycode) "\1\2" SYMBOL_STR(keycode)
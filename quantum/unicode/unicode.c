@@ -389,3 +389,50 @@ void send_unicode_string(const char *str) {
         }
     }
 }
+
+#ifdef SEND_STRING_ASYNC_QUEUE_SIZE
+typedef struct send_unicode_string_state_t {
+    const char *str;
+    char        buffer[5];
+    uint8_t     index;
+    uint8_t     count;
+} send_unicode_string_state_t;
+
+// Expands each code point into an `SS_UNICODE_CODE` escape for the send_string queue
+static char send_unicode_string_get_next(void *arg) {
+    send_unicode_string_state_t *state = (send_unicode_string_state_t *)arg;
+    while (state->index == state->count) {
+        if (!*state->str) {
+            return 0;
+        }
+
+        int32_t code_point = 0;
+        state->str         = decode_utf8(state->str, &code_point);
+        if (code_point < 0) {
+            continue;
+        }
+
+        state->buffer[0] = SS_QMK_PREFIX;
+        state->buffer[1] = SS_UNICODE_CODE;
+        state->buffer[2] = 0x80 | ((code_point >> 14) & 0x7F);
+        state->buffer[3] = 0x80 | ((code_point >> 7) & 0x7F);
+        state->buffer[4] = 0x80 | (code_point & 0x7F);
+        state->index     = 0;
+        state->count     = 5;
+    }
+    return state->buffer[state->index++];
+}
+
+void send_unicode_string_async(const char *str) {
+    if (!str) {
+        return;
+    }
+
+    send_unicode_string_state_t state = {.str = str};
+    if (!send_string_async_impl(send_unicode_string_get_next, &state)) {
+        // too long for the queue, type it out once the queue has drained
+        send_string_async_flush();
+        send_unicode_string(str);
+    }
+}
+#endif
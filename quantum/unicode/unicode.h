@@ -133,4 +133,15 @@ void register_unicode(uint32_t code_point);
  */
 void send_unicode_string(const char *str);
 
+#if defined(SEND_STRING_ASYNC_QUEUE_SIZE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string containing Unicode characters to be sent from the main loop, see `send_string_async()`.
+ *
+ * Falls back to `send_unicode_string()` if the string does not fit in the queue.
+ *
+ * \param str The string to send.
+ */
+void send_unicode_string_async(const char *str);
+#endif
+
 /** \} */
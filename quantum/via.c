@@ -65,6 +65,11 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(AUTOCORRECT_DATA_FLASH)
+#    include "process_autocorrect.h"
+#    include "autocorrect_flash.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -232,6 +237,7 @@ __attribute__((weak)) void via_custom_value_command_kb(uint8_t *data, uint8_t le
 //      id_qmk_rgb_matrix_channel   ->  via_qmk_rgb_matrix_command()
 //      id_qmk_led_matrix_channel   ->  via_qmk_led_matrix_command()
 //      id_qmk_audio_channel        ->  via_qmk_audio_command()
+//      id_qmk_autocorrect_channel  ->  via_qmk_autocorrect_command()
 //
 __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t length) {
     // data = [ command_id, channel_id, value_id, value_data ]
@@ -272,6 +278,13 @@ __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t lengt
     }
 #endif // AUDIO_ENABLE
 
+#if defined(AUTOCORRECT_DATA_FLASH)
+    if (*channel_id == id_qmk_autocorrect_channel) {
+        via_qmk_autocorrect_command(data, length);
+        return;
+    }
+#endif // AUTOCORRECT_DATA_FLASH
+
     (void)channel_id; // force use of variable
 
     // If we haven't returned before here, then let the keyboard level code
@@ -819,6 +832,91 @@ void via_qmk_led_matrix_save(void) {
 
 #endif // LED_MATRIX_ENABLE
 
+#if defined(AUTOCORRECT_DATA_FLASH)
+
+void via_qmk_autocorrect_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, value_id, value_data ]
+    uint8_t *command_id        = &(data[0]);
+    uint8_t *value_id_and_data = &(data[2]);
+
+    switch (*command_id) {
+        case id_custom_set_value: {
+            // Failed dictionary uploads are reported as unhandled
+            if (!via_qmk_autocorrect_set_value(value_id_and_data)) {
+                *command_id = id_unhandled;
+            }
+            break;
+        }
+        case id_custom_get_value: {
+            via_qmk_autocorrect_get_value(value_id_and_data);
+            break;
+        }
+        case id_custom_save: {
+            // Enabling is saved straight away
+            break;
+        }
+        default: {
+            *command_id = id_unhandled;
+            break;
+        }
+    }
+}
+
+void via_qmk_autocorrect_get_value(uint8_t *data) {
+    // data = [ value_id, value_data ]
+    uint8_t *value_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    switch (*value_id) {
+        case id_qmk_autocorrect_enable: {
+            value_data[0] = autocorrect_is_enabled() ? 1 : 0;
+            break;
+        }
+        case id_qmk_autocorrect_dictionary_size: {
+            // Size of the image in flash, 0 while the built in dictionary is used
+            const autocorrect_flash_header_t *dictionary = autocorrect_flash_dictionary();
+            uint32_t                          value      = dictionary ? dictionary->page_size + dictionary->size : 0;
+            value_data[0]                                = (value >> 24) & 0xFF;
+            value_data[1]                                = (value >> 16) & 0xFF;
+            value_data[2]                                = (value >> 8) & 0xFF;
+            value_data[3]                                = value & 0xFF;
+            break;
+        }
+    }
+}
+
+bool via_qmk_autocorrect_set_value(uint8_t *data) {
+    // data = [ value_id, value_data ]
+    uint8_t *value_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    switch (*value_id) {
+        case id_qmk_autocorrect_enable: {
+            if (value_data[0]) {
+                autocorrect_enable();
+            } else {
+                autocorrect_disable();
+            }
+            return true;
+        }
+        case id_qmk_autocorrect_dictionary_size: {
+            // value_data = [ size (4 bytes) ], starts an upload of that size
+            uint32_t size = ((uint32_t)value_data[0] << 24) | ((uint32_t)value_data[1] << 16) | ((uint32_t)value_data[2] << 8) | value_data[3];
+            return autocorrect_flash_write_begin(size);
+        }
+        case id_qmk_autocorrect_dictionary_data: {
+            // value_data = [ offset (3 bytes), size, data ], size <= 25
+            uint32_t offset = ((uint32_t)value_data[0] << 16) | ((uint32_t)value_data[1] << 8) | value_data[2];
+            uint8_t  size   = value_data[3];
+            return size <= 25 && autocorrect_flash_write(offset, &value_data[4], size);
+        }
+        case id_qmk_autocorrect_dictionary_commit: {
+            return autocorrect_flash_write_end();
+        }
+    }
+    return true;
+}
+
+#endif // AUTOCORRECT_DATA_FLASH
+
 #if defined(AUDIO_ENABLE)
 
 extern audio_config_t audio_config;
@@ -85,12 +85,13 @@ enum via_keyboard_value_id {
 };
 
 enum via_channel_id {
-    id_custom_channel         = 0,
-    id_qmk_backlight_channel  = 1,
-    id_qmk_rgblight_channel   = 2,
-    id_qmk_rgb_matrix_channel = 3,
-    id_qmk_audio_channel      = 4,
-    id_qmk_led_matrix_channel = 5,
+    id_custom_channel          = 0,
+    id_qmk_backlight_channel   = 1,
+    id_qmk_rgblight_channel    = 2,
+    id_qmk_rgb_matrix_channel  = 3,
+    id_qmk_audio_channel       = 4,
+    id_qmk_led_matrix_channel  = 5,
+    id_qmk_autocorrect_channel = 6,
 };
 
 enum via_qmk_backlight_value {
@@ -118,6 +119,13 @@ enum via_qmk_led_matrix_value {
     id_qmk_led_matrix_effect_speed = 3,
 };
 
+enum via_qmk_autocorrect_value {
+    id_qmk_autocorrect_enable            = 1,
+    id_qmk_autocorrect_dictionary_size   = 2,
+    id_qmk_autocorrect_dictionary_data   = 3,
+    id_qmk_autocorrect_dictionary_commit = 4,
+};
+
 enum via_qmk_audio_value {
     id_qmk_audio_enable        = 1,
     id_qmk_audio_clicky_enable = 2,
@@ -182,6 +190,12 @@ void via_qmk_led_matrix_get_value(uint8_t *data);
 void via_qmk_led_matrix_save(void);
 #endif
 
+#if defined(AUTOCORRECT_DATA_FLASH)
+void via_qmk_autocorrect_command(uint8_t *data, uint8_t length);
+bool via_qmk_autocorrect_set_value(uint8_t *data);
+void via_qmk_autocorrect_get_value(uint8_t *data);
+#endif
+
 #if defined(AUDIO_ENABLE)
 void via_qmk_audio_command(uint8_t *data, uint8_t length);
 void via_qmk_audio_set_value(uint8_t *data);
@@ -0,0 +1,13 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE = yes
+
+# The 5,000 entry dictionary is generated rather than checked in
+AUTOCORRECT_BENCHMARK_DATA := $(BUILD_DIR)/test_obj/$(TEST_OUTPUT)/autocorrect_benchmark
+$(shell python3 $(TEST_PATH)/../autocorrect_large_dictionary/generate_autocorrect_data.py $(AUTOCORRECT_BENCHMARK_DATA)/autocorrect_data.h)
+VPATH += $(AUTOCORRECT_BENCHMARK_DATA)
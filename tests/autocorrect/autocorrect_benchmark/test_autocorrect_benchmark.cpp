@@ -0,0 +1,54 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+#define BENCHMARK_KEYSTROKES 1000000
+
+class AutoCorrectBenchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+};
+
+// Not a pass/fail test: reports the average cost of `process_autocorrect()` per
+// keystroke of random words with the 5,000 entry dictionary.
+TEST_F(AutoCorrectBenchmark, KeystrokeCost) {
+    TestDriver driver;
+    // The odd random typo is corrected
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    std::mt19937                       rng(5000);
+    std::discrete_distribution<int>    letter({82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1});
+    std::uniform_int_distribution<int> word_length(2, 10);
+
+    std::vector<uint16_t> keycodes;
+    while (keycodes.size() < BENCHMARK_KEYSTROKES) {
+        for (int i = word_length(rng); i > 0; i--) {
+            keycodes.push_back(KC_A + letter(rng));
+        }
+        keycodes.push_back(KC_SPACE);
+    }
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t keycode : keycodes) {
+        record.event.pressed = true;
+        process_autocorrect(keycode, &record);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("autocorrect, 5000 entries: %.1f ns/keystroke\n", (double)elapsed.count() / keycodes.size());
+
+    VERIFY_AND_CLEAR(driver);
+}
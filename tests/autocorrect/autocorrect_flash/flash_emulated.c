@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "flash_emulated.h"
+#include <string.h>
+#include "flash.h"
+
+#define FLASH_EMULATED_SIZE (512 * 1024L)
+#define FLASH_EMULATED_SECTOR_SIZE (4 * 1024L)
+
+// Behaves like NOR flash: erasing sets bytes to 0xFF, writing can only clear bits
+static uint8_t flash[FLASH_EMULATED_SIZE];
+
+uint32_t flash_emulated_reads      = 0;
+uint32_t flash_emulated_read_bytes = 0;
+
+uint8_t *flash_emulated_data(void) {
+    return flash;
+}
+
+void flash_init(void) {}
+
+flash_status_t flash_is_busy(void) {
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_begin_erase_chip(void) {
+    memset(flash, 0xFF, sizeof(flash));
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_wait_erase_chip(void) {
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_erase_chip(void) {
+    return flash_begin_erase_chip();
+}
+
+flash_status_t flash_erase_block(uint32_t addr) {
+    return FLASH_STATUS_ERROR;
+}
+
+flash_status_t flash_erase_sector(uint32_t addr) {
+    if (addr % FLASH_EMULATED_SECTOR_SIZE || addr >= FLASH_EMULATED_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memset(flash + addr, 0xFF, FLASH_EMULATED_SECTOR_SIZE);
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
+    if (addr + len > FLASH_EMULATED_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memcpy(buf, flash + addr, len);
+    flash_emulated_reads++;
+    flash_emulated_read_bytes += len;
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_write_range(uint32_t addr, const void *buf, size_t len) {
+    if (addr + len > FLASH_EMULATED_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    for (size_t i = 0; i < len; i++) {
+        flash[addr + i] &= ((const uint8_t *)buf)[i];
+    }
+    return FLASH_STATUS_SUCCESS;
+}
@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Read transactions and bytes read so far, to measure the cost of lookups
+extern uint32_t flash_emulated_reads;
+extern uint32_t flash_emulated_read_bytes;
+
+uint8_t *flash_emulated_data(void);
+
+#ifdef __cplusplus
+}
+#endif
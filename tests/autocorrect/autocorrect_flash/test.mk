@@ -0,0 +1,17 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE = yes
+AUTOCORRECT_DATA_DRIVER = flash
+FLASH_DRIVER = custom
+
+SRC += flash_emulated.c
+
+# The 5,000 entry dictionary image is generated rather than checked in
+AUTOCORRECT_FLASH_IMAGE := $(BUILD_DIR)/test_obj/$(TEST_OUTPUT)/autocorrect_flash
+$(shell python3 $(TEST_PATH)/../autocorrect_large_dictionary/generate_autocorrect_data.py --flash $(AUTOCORRECT_FLASH_IMAGE)/autocorrect_flash_image.h)
+VPATH += $(AUTOCORRECT_FLASH_IMAGE)
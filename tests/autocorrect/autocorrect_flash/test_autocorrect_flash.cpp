@@ -0,0 +1,195 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "flash_emulated.h"
+#include "autocorrect_flash_image.h"
+
+extern "C" {
+#include "autocorrect_flash.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+#define SCAN_BUDGET_KEYSTROKES 100000
+
+// Flash read cost assumed for the scan budget: an 8 MHz SPI clock moves a
+// byte per microsecond, and every read sends a command and a 24 bit address.
+#define FLASH_BYTES_PER_US 1
+#define FLASH_READ_OVERHEAD 4
+#define SCAN_BUDGET_US 1000
+
+class AutoCorrectFlash : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+    // Convenience function to tap `key`.
+    void TapKey(KeymapKey key) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+
+    // Taps in order each key in `keys`.
+    template <typename... Ts>
+    void TapKeys(Ts... keys) {
+        for (KeymapKey key : {keys...}) {
+            TapKey(key);
+        }
+    }
+
+    // Uploads `image` in parts as large as the VIA command allows.
+    bool Upload(const uint8_t *image, uint32_t size) {
+        if (!autocorrect_flash_write_begin(size)) {
+            return false;
+        }
+        for (uint32_t offset = 0; offset < size; offset += 25) {
+            if (!autocorrect_flash_write(offset, image + offset, std::min<uint32_t>(25, size - offset))) {
+                return false;
+            }
+        }
+        return autocorrect_flash_write_end();
+    }
+};
+
+TEST_F(AutoCorrectFlash, UploadedDictionaryIsUsed) {
+    TestDriver driver;
+    auto       key_spc = KeymapKey(0, 0, 0, KC_SPACE);
+    auto       key_b   = KeymapKey(0, 1, 0, KC_B);
+    auto       key_e   = KeymapKey(0, 2, 0, KC_E);
+    auto       key_c   = KeymapKey(0, 3, 0, KC_C);
+    auto       key_u   = KeymapKey(0, 4, 0, KC_U);
+    auto       key_a   = KeymapKey(0, 5, 0, KC_A);
+    auto       key_s   = KeymapKey(0, 6, 0, KC_S);
+
+    set_keymap({key_spc, key_b, key_e, key_c, key_u, key_a, key_s});
+
+    ASSERT_TRUE(Upload(autocorrect_flash_image, sizeof(autocorrect_flash_image)));
+    ASSERT_NE(autocorrect_flash_dictionary(), nullptr);
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_SPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE))).Times(4);
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_SPACE)));
+    }
+
+    TapKeys(key_spc, key_b, key_e, key_c, key_u, key_a, key_s, key_e, key_spc);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoCorrectFlash, InterruptedUploadFallsBackToBuiltInDictionary) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    ASSERT_TRUE(autocorrect_flash_write_begin(sizeof(autocorrect_flash_image)));
+    ASSERT_TRUE(autocorrect_flash_write(0, autocorrect_flash_image, 25));
+    EXPECT_FALSE(autocorrect_flash_write_end());
+    EXPECT_EQ(autocorrect_flash_dictionary(), nullptr);
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_f, key_a, key_l, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoCorrectFlash, CorruptedUploadIsRejected) {
+    std::vector<uint8_t> image(autocorrect_flash_image, autocorrect_flash_image + sizeof(autocorrect_flash_image));
+    image[image.size() / 2] ^= 1;
+
+    EXPECT_FALSE(Upload(image.data(), image.size()));
+    EXPECT_EQ(autocorrect_flash_dictionary(), nullptr);
+}
+
+TEST_F(AutoCorrectFlash, OutOfOrderWriteIsRejected) {
+    ASSERT_TRUE(autocorrect_flash_write_begin(sizeof(autocorrect_flash_image)));
+    ASSERT_TRUE(autocorrect_flash_write(0, autocorrect_flash_image, 25));
+    EXPECT_FALSE(autocorrect_flash_write(50, autocorrect_flash_image + 50, 25));
+    EXPECT_FALSE(autocorrect_flash_write_end());
+}
+
+TEST_F(AutoCorrectFlash, OversizedUploadIsRejected) {
+    EXPECT_FALSE(autocorrect_flash_write_begin(AUTOCORRECT_FLASH_MAX_SIZE + 1));
+}
+
+// Checks that the flash reads of the worst keystroke of random words with the
+// 5,000 entry dictionary in flash fit in the scan budget.
+TEST_F(AutoCorrectFlash, WorstKeystrokeFitsScanBudget) {
+    TestDriver driver;
+    // The odd random typo is corrected
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    ASSERT_TRUE(Upload(autocorrect_flash_image, sizeof(autocorrect_flash_image)));
+
+    std::mt19937                       rng(5000);
+    std::discrete_distribution<int>    letter({82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1});
+    std::uniform_int_distribution<int> word_length(2, 10);
+
+    std::vector<uint16_t> keycodes;
+    while (keycodes.size() < SCAN_BUDGET_KEYSTROKES) {
+        for (int i = word_length(rng); i > 0; i--) {
+            keycodes.push_back(KC_A + letter(rng));
+        }
+        keycodes.push_back(KC_SPACE);
+    }
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    uint32_t worst_bytes = 0;
+    for (uint16_t keycode : keycodes) {
+        uint32_t before_reads = flash_emulated_reads;
+        uint32_t before_bytes = flash_emulated_read_bytes;
+
+        record.event.pressed = true;
+        process_autocorrect(keycode, &record);
+
+        uint32_t bytes = (flash_emulated_read_bytes - before_bytes) + (flash_emulated_reads - before_reads) * FLASH_READ_OVERHEAD;
+        worst_bytes    = std::max(worst_bytes, bytes);
+    }
+
+    EXPECT_LE(worst_bytes / FLASH_BYTES_PER_US, SCAN_BUDGET_US);
+
+    VERIFY_AND_CLEAR(driver);
+}
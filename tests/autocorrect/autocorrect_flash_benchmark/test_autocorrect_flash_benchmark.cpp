@@ -0,0 +1,93 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "flash_emulated.h"
+#include "autocorrect_flash_image.h"
+
+extern "C" {
+#include "autocorrect_flash.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+#define BENCHMARK_KEYSTROKES 1000000
+
+// Flash read cost assumed for the scan budget: an 8 MHz SPI clock moves a
+// byte per microsecond, and every read sends a command and a 24 bit address.
+#define FLASH_BYTES_PER_US 1
+#define FLASH_READ_OVERHEAD 4
+
+class AutoCorrectFlashBenchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+
+    // Uploads `image` in parts as large as the VIA command allows.
+    bool Upload(const uint8_t *image, uint32_t size) {
+        if (!autocorrect_flash_write_begin(size)) {
+            return false;
+        }
+        for (uint32_t offset = 0; offset < size; offset += 25) {
+            if (!autocorrect_flash_write(offset, image + offset, std::min<uint32_t>(25, size - offset))) {
+                return false;
+            }
+        }
+        return autocorrect_flash_write_end();
+    }
+};
+
+// Not a pass/fail test: reports the average cost of `process_autocorrect()` per
+// keystroke of random words with the 5,000 entry dictionary in flash, along
+// with the flash reads it takes and those of the worst keystroke.
+TEST_F(AutoCorrectFlashBenchmark, KeystrokeCost) {
+    TestDriver driver;
+    // The odd random typo is corrected
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    ASSERT_TRUE(Upload(autocorrect_flash_image, sizeof(autocorrect_flash_image)));
+
+    std::mt19937                       rng(5000);
+    std::discrete_distribution<int>    letter({82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1});
+    std::uniform_int_distribution<int> word_length(2, 10);
+
+    std::vector<uint16_t> keycodes;
+    while (keycodes.size() < BENCHMARK_KEYSTROKES) {
+        for (int i = word_length(rng); i > 0; i--) {
+            keycodes.push_back(KC_A + letter(rng));
+        }
+        keycodes.push_back(KC_SPACE);
+    }
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    uint32_t reads       = flash_emulated_reads;
+    uint32_t read_bytes  = flash_emulated_read_bytes;
+    uint32_t worst_bytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t keycode : keycodes) {
+        uint32_t before_reads = flash_emulated_reads;
+        uint32_t before_bytes = flash_emulated_read_bytes;
+
+        record.event.pressed = true;
+        process_autocorrect(keycode, &record);
+
+        uint32_t bytes = (flash_emulated_read_bytes - before_bytes) + (flash_emulated_reads - before_reads) * FLASH_READ_OVERHEAD;
+        worst_bytes    = std::max(worst_bytes, bytes);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("autocorrect flash, 5000 entries: %.1f ns/keystroke, %.3f flash reads/keystroke, %.1f bytes/keystroke, worst %u bytes (%u us)\n", (double)elapsed.count() / keycodes.size(), (double)(flash_emulated_reads - reads) / keycodes.size(), (double)(flash_emulated_read_bytes - read_bytes) / keycodes.size(), worst_bytes, worst_bytes / FLASH_BYTES_PER_US);
+
+    VERIFY_AND_CLEAR(driver);
+}
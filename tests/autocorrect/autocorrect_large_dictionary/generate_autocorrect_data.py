@@ -0,0 +1,77 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Writes the autocorrect_data.h used by the large dictionary tests and benchmark.
+
+The dictionary has 5,000 synthetic typos, made by swapping two letters of
+random words, and is serialized the same way as `qmk generate-autocorrect-data`.
+All typos have the same length, so none of them can be a substring of another.
+
+With --flash, the same dictionary is written as an external flash image
+instead, in a header for the flash tests.
+"""
+import random
+import sys
+import textwrap
+from pathlib import Path
+
+sys.path.append(str(Path(__file__).resolve().parents[3] / 'lib' / 'python'))
+
+from qmk.autocorrect import autocorrect_data_lines, autocorrect_flash_image, make_trie, serialize_trie, to_hex  # noqa: E402
+
+ENTRIES = 5000
+TYPO_LENGTH = 9
+
+# Known entries for the tests, the rest is random
+FIXED = [(':becuase:', 'because'), ('fitlering', 'filtering')]
+
+# English letter frequencies, so the trie branches like a real dictionary
+LETTERS = 'etaoinshrdlcumwfgypbvkjxqz'
+WEIGHTS = [127, 91, 82, 75, 70, 67, 63, 61, 60, 43, 40, 28, 28, 24, 24, 22, 20, 20, 19, 15, 10, 8, 2, 2, 1, 1]
+
+
+def make_autocorrections():
+    rng = random.Random(5000)
+    autocorrections = list(FIXED)
+    typos = set(typo for typo, _ in FIXED)
+
+    while len(autocorrections) < ENTRIES:
+        # A word break on either side counts towards the typo length
+        boundary = rng.choice(['', 'start', 'end'])
+        word = ''.join(rng.choices(LETTERS, WEIGHTS, k=TYPO_LENGTH - (boundary != '')))
+        i = rng.randrange(len(word) - 1)
+        if word[i] == word[i + 1]:
+            continue
+        typo = word[:i] + word[i + 1] + word[i] + word[i + 2:]
+        if boundary == 'start':
+            typo = ':' + typo
+        elif boundary == 'end':
+            typo = typo + ':'
+        if typo in typos:
+            continue
+        typos.add(typo)
+        autocorrections.append((typo, word))
+
+    return autocorrections
+
+
+def write_if_changed(output: Path, lines: list) -> None:
+    # Left untouched when unchanged, so the test isn't rebuilt on every run
+    content = '\n'.join(lines) + '\n'
+    if not output.exists() or output.read_text() != content:
+        output.parent.mkdir(parents=True, exist_ok=True)
+        output.write_text(content)
+
+
+if __name__ == '__main__':
+    autocorrections = make_autocorrections()
+    lines = ['// Generated by generate_autocorrect_data.py, do not edit.', '', '#pragma once', '']
+    if sys.argv[1] == '--flash':
+        image = autocorrect_flash_image(autocorrections)
+        lines.append(f'static const uint8_t autocorrect_flash_image[{len(image)}] = {{')
+        lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, image))), width=100, subsequent_indent='    '))
+        lines.append('};')
+        write_if_changed(Path(sys.argv[2]), lines)
+    else:
+        data, link_size = serialize_trie(make_trie(autocorrections))
+        lines += autocorrect_data_lines(autocorrections, data, link_size)
+        write_if_changed(Path(sys.argv[1]), lines)
@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+class AutoCorrectLargeDictionary : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+    // Convenience function to tap `key`.
+    void TapKey(KeymapKey key) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+
+    // Taps in order each key in `keys`.
+    template <typename... Ts>
+    void TapKeys(Ts... keys) {
+        for (KeymapKey key : {keys...}) {
+            TapKey(key);
+        }
+    }
+};
+
+// Test that " becuase " is corrected with the 5,000 entry dictionary, which needs 24 bit links
+TEST_F(AutoCorrectLargeDictionary, becuase_to_because_autocorrection) {
+    TestDriver driver;
+    auto       key_spc = KeymapKey(0, 0, 0, KC_SPACE);
+    auto       key_b   = KeymapKey(0, 1, 0, KC_B);
+    auto       key_e   = KeymapKey(0, 2, 0, KC_E);
+    auto       key_c   = KeymapKey(0, 3, 0, KC_C);
+    auto       key_u   = KeymapKey(0, 4, 0, KC_U);
+    auto       key_a   = KeymapKey(0, 5, 0, KC_A);
+    auto       key_s   = KeymapKey(0, 6, 0, KC_S);
+
+    set_keymap({key_spc, key_b, key_e, key_c, key_u, key_a, key_s});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_SPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE))).Times(4);
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_SPACE)));
+    }
+
+    TapKeys(key_spc, key_b, key_e, key_c, key_u, key_a, key_s, key_e, key_spc);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+#define BENCHMARK_KEY_EVENTS 1000000
+
+class ProcessRecordBenchmark : public TestFixture {};
+
+// Not a pass/fail test: reports the average cost of `process_record_quantum()`
+// per key event of a basic keycode, with 15 features enabled.
+TEST_F(ProcessRecordBenchmark, BasicKeyEventCost) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    auto key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_KEY_EVENTS; i++) {
+        record.event.pressed = !(i & 1);
+        record.event.time    = timer_read();
+        process_record_quantum(&record);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("process_record_quantum, basic keycode: %.1f ns/key event\n", (double)elapsed.count() / BENCHMARK_KEY_EVENTS);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+class ProcessRecordDispatch : public TestFixture {};
+
+// Test that keycodes of a handler late in the chain still reach it
+TEST_F(ProcessRecordDispatch, GraveEscapeIsHandled) {
+    TestDriver driver;
+    auto       key_grave_esc = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+
+    set_keymap({key_grave_esc});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_grave_esc);
+    VERIFY_AND_CLEAR(driver);
+}
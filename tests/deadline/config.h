@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define CAPS_WORD_IDLE_TIMEOUT 1000
+#define LAYER_LOCK_IDLE_TIMEOUT 2000
+#define SECURE_UNLOCK_TIMEOUT 3000
+#define AUTO_SHIFT_TIMEOUT 150
+#define KEY_OVERRIDE_REPEAT_DELAY 500
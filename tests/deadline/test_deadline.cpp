@@ -0,0 +1,166 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class Deadline : public TestFixture {
+   public:
+    void SetUp() override {
+        caps_word_off();
+        layer_lock_all_off();
+        secure_lock();
+    }
+};
+
+TEST_F(Deadline, NothingPendingWhenIdle) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    caps_word_on();
+    EXPECT_TRUE(deadline_pending(DEADLINE_CAPS_WORD));
+    caps_word_off();
+    EXPECT_FALSE(deadline_pending(DEADLINE_CAPS_WORD));
+
+    layer_lock_on(1);
+    EXPECT_TRUE(deadline_pending(DEADLINE_LAYER_LOCK));
+    layer_lock_off(1);
+    EXPECT_FALSE(deadline_pending(DEADLINE_LAYER_LOCK));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Deadline, CancelledDeadlinesDoNotFire) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    caps_word_on();
+    layer_lock_on(1);
+    idle_for(CAPS_WORD_IDLE_TIMEOUT / 2);
+    caps_word_off();
+    layer_lock_off(1);
+
+    // Turning them back on starts the timeouts over
+    caps_word_on();
+    layer_lock_on(1);
+    idle_for(CAPS_WORD_IDLE_TIMEOUT);
+    EXPECT_TRUE(is_caps_word_on());
+    idle_for(LAYER_LOCK_IDLE_TIMEOUT - CAPS_WORD_IDLE_TIMEOUT + 1);
+    EXPECT_TRUE(is_layer_locked(1));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Deadline, EarliestDeadlineFiresFirst) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    secure_request_unlock();
+    layer_lock_on(1);
+    caps_word_on();
+
+    idle_for(CAPS_WORD_IDLE_TIMEOUT);
+    EXPECT_TRUE(is_caps_word_on());
+    idle_for(1);
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_TRUE(is_layer_locked(1));
+    EXPECT_FALSE(deadline_pending(DEADLINE_CAPS_WORD));
+
+    // Layer Lock only times out once more than its timeout has passed
+    idle_for(LAYER_LOCK_IDLE_TIMEOUT - CAPS_WORD_IDLE_TIMEOUT);
+    EXPECT_TRUE(is_layer_locked(1));
+    idle_for(1);
+    EXPECT_FALSE(is_layer_locked(1));
+    EXPECT_TRUE(secure_is_unlocking());
+    EXPECT_FALSE(deadline_pending(DEADLINE_LAYER_LOCK));
+
+    idle_for(SECURE_UNLOCK_TIMEOUT - LAYER_LOCK_IDLE_TIMEOUT - 2);
+    EXPECT_TRUE(secure_is_unlocking());
+    idle_for(1);
+    EXPECT_TRUE(secure_is_locked());
+    EXPECT_FALSE(deadline_pending(DEADLINE_SECURE));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Deadline, ActivityPushesDeadlineBack) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    caps_word_on();
+    idle_for(CAPS_WORD_IDLE_TIMEOUT / 2);
+    tap_key(key_a);
+    idle_for(CAPS_WORD_IDLE_TIMEOUT / 2 + 1);
+    EXPECT_TRUE(is_caps_word_on());
+
+    idle_for(CAPS_WORD_IDLE_TIMEOUT / 2);
+    EXPECT_FALSE(is_caps_word_on());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Deadline, AutoShiftKeyHeldPastTimeoutIsShifted) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    idle_for(AUTO_SHIFT_TIMEOUT);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Shifted as soon as the timeout has passed, without waiting for the release */
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Deadline, KeyOverrideRegistersAfterRepeatDelay) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_esc   = KeymapKey(0, 1, 0, KC_ESC);
+
+    set_keymap({key_shift, key_esc});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_esc.press();
+    run_one_scan_loop();
+    idle_for(99);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Shift arriving while Esc is held replaces it, but Home only once the repeat delay has passed since the press of Esc */
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY - 100 - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_HOME));
+    idle_for(1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_esc.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for 8 whole key records, which used to be 4 taps
+#define DYNAMIC_MACRO_SIZE 8
+
+// Room for 4 keys pressed and released during playback
+#define DYNAMIC_MACRO_PLAY_QUEUE_SIZE 8
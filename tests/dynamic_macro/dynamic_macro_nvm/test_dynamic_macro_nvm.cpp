@@ -0,0 +1,119 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacroNvm : public TestFixture {
+   public:
+    void WaitForPlayback() {
+        for (int i = 0; i < 1000 && dynamic_macro_is_playing(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(dynamic_macro_is_playing());
+    }
+};
+
+TEST_F(DynamicMacroNvm, MacrosArePersisted) {
+    TestDriver driver;
+
+    auto key_rec1 = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_rec2 = KeymapKey(0, 1, 0, DM_REC2);
+    auto key_stop = KeymapKey(0, 2, 0, DM_RSTP);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec1, key_rec2, key_stop, key_a, key_b});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_keys(key_a, key_b);
+    tap_key(key_stop);
+    tap_key(key_rec2);
+    tap_key(key_b);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    uint16_t length[2];
+    eeconfig_read_dynamic_macro(length, 0, sizeof(length));
+    EXPECT_EQ(length[0], 12);
+    EXPECT_EQ(length[1], 6);
+
+    // Macro 2 ends at the end of the block, the key of its release is the second byte from the end
+    uint8_t key;
+    eeconfig_read_dynamic_macro(&key, DYNAMIC_MACRO_NVM_SIZE - 2, sizeof(key));
+    EXPECT_EQ(key, 0 << 4 | 4);
+}
+
+TEST_F(DynamicMacroNvm, MacroIsPlayedFromNvm) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    tap_key(key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // Moves the recorded taps from A to B behind the back of the RAM buffer
+    uint8_t key = 0 << 4 | 4;
+    eeconfig_update_dynamic_macro(&key, 2 * sizeof(uint16_t) + 1, sizeof(key));
+    eeconfig_update_dynamic_macro(&key, 2 * sizeof(uint16_t) + 4, sizeof(key));
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B));
+    tap_key(key_play);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroNvm, RecordingIsLimitedByNvm) {
+    TestDriver driver;
+
+    auto key_rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    auto key_stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    auto key_play2 = KeymapKey(0, 3, 0, DM_PLY2);
+    auto key_a     = KeymapKey(0, 4, 0, KC_A);
+
+    set_keymap({key_rec1, key_rec2, key_stop, key_play2, key_a});
+
+    // Macro 1 takes 48 of the 60 bytes
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    for (int i = 0; i < 8; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+
+    // Leaving room for 2 taps of macro 2
+    tap_key(key_rec2);
+    for (int i = 0; i < 4; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(2);
+    tap_key(key_play2);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,343 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+// Key events ignored because the play queue was full
+static std::vector<keyevent_t> ignored_events;
+
+extern "C" void dynamic_macro_play_queue_full_user(keyrecord_t *record) {
+    ignored_events.push_back(record->event);
+}
+
+class DynamicMacro : public TestFixture {
+   public:
+    void SetUp() override {
+        ignored_events.clear();
+    }
+
+    void WaitForPlayback() {
+        for (int i = 0; i < 1000 && dynamic_macro_is_playing(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(dynamic_macro_is_playing());
+    }
+};
+
+TEST_F(DynamicMacro, PlaybackIsSpreadOverScanLoops) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    tap_key(key_rec);
+    tap_keys(key_a, key_b);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing is sent by the scan loop the macro starts in
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    tap_key(key_play);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+    }
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, CompactEventsFitSeveralTimesAsMany) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+
+    // 20 events, where the buffer held 8 whole key records
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    for (int i = 0; i < 5; i++) {
+        tap_keys(key_a, key_b);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(5);
+    EXPECT_REPORT(driver, (KC_B)).Times(5);
+    tap_key(key_play);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, MacrosShareTheBuffer) {
+    TestDriver driver;
+
+    auto key_rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    auto key_stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    auto key_play1 = KeymapKey(0, 3, 0, DM_PLY1);
+    auto key_play2 = KeymapKey(0, 4, 0, DM_PLY2);
+    auto key_a     = KeymapKey(0, 5, 0, KC_A);
+    auto key_b     = KeymapKey(0, 6, 0, KC_B);
+
+    set_keymap({key_rec1, key_rec2, key_stop, key_play1, key_play2, key_a, key_b});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    tap_key(key_stop);
+    tap_key(key_rec2);
+    tap_key(key_b);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play1);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B));
+    tap_key(key_play2);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, NestedMacroIsPlayedInPlace) {
+    TestDriver driver;
+
+    auto key_rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    auto key_stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    auto key_play1 = KeymapKey(0, 3, 0, DM_PLY1);
+    auto key_play2 = KeymapKey(0, 4, 0, DM_PLY2);
+    auto key_a     = KeymapKey(0, 5, 0, KC_A);
+    auto key_b     = KeymapKey(0, 6, 0, KC_B);
+    auto key_c     = KeymapKey(0, 7, 0, KC_C);
+
+    set_keymap({key_rec1, key_rec2, key_stop, key_play1, key_play2, key_a, key_b, key_c});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    tap_key(key_stop);
+    tap_key(key_rec2);
+    tap_keys(key_b, key_play1, key_c);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_C));
+    }
+    tap_key(key_play2);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RecursiveMacroIsIgnored) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({key_rec, key_stop, key_play, key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    tap_keys(key_a, key_play);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(key_play);
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, KeysDuringPlaybackWaitForIt) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_mo   = KeymapKey(0, 2, 0, MO(1));
+    auto key_play = KeymapKey(1, 3, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 4, 0, KC_A);
+    auto key_x    = KeymapKey(1, 4, 0, KC_X);
+    auto key_b    = KeymapKey(0, 5, 0, KC_B);
+    auto key_c    = KeymapKey(0, 6, 0, KC_C);
+    auto key_y    = KeymapKey(1, 6, 0, KC_Y);
+
+    set_keymap({key_rec, key_stop, key_mo, key_play, key_a, key_x, key_b, key_c, key_y});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    for (int i = 0; i < 3; i++) {
+        tap_keys(key_a, key_b);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_C));
+    }
+    key_mo.press();
+    run_one_scan_loop();
+    tap_key(key_play);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+
+    // Leaving the layer the macro was played from, then typing on the base layer
+    key_mo.release();
+    run_one_scan_loop();
+    tap_key(key_c);
+    WaitForPlayback();
+    EXPECT_FALSE(layer_state_is(1));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, KeyLockDuringPlaybackIsProcessedOnce) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_lock = KeymapKey(0, 4, 0, QK_LOCK);
+    auto key_c    = KeymapKey(0, 5, 0, KC_C);
+
+    set_keymap({key_rec, key_stop, key_play, key_a, key_lock, key_c});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    tap_key(key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+    }
+    tap_key(key_play);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+
+    // C stays held once its release is replayed
+    tap_key(key_lock);
+    tap_key(key_c);
+    WaitForPlayback();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, KeysBeyondTheQueueAreIgnored) {
+    TestDriver driver;
+
+    auto key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    auto key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    auto key_play = KeymapKey(0, 2, 0, DM_PLY1);
+    auto key_a    = KeymapKey(0, 3, 0, KC_A);
+    auto key_b    = KeymapKey(0, 4, 0, KC_B);
+    auto key_c    = KeymapKey(0, 5, 0, KC_C);
+    auto key_d    = KeymapKey(0, 6, 0, KC_D);
+    auto key_e    = KeymapKey(0, 7, 0, KC_E);
+    auto key_f    = KeymapKey(0, 8, 0, KC_F);
+    auto key_g    = KeymapKey(0, 9, 0, KC_G);
+
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b, key_c, key_d, key_e, key_f, key_g});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tap_key(key_rec);
+    for (int i = 0; i < 3; i++) {
+        tap_keys(key_a, key_b);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        for (int i = 0; i < 3; i++) {
+            EXPECT_REPORT(driver, (KC_A));
+            EXPECT_REPORT(driver, (KC_B));
+        }
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_REPORT(driver, (KC_C, KC_D));
+        EXPECT_REPORT(driver, (KC_C, KC_D, KC_E));
+        EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F));
+        EXPECT_REPORT(driver, (KC_D, KC_E, KC_F));
+        EXPECT_REPORT(driver, (KC_E, KC_F));
+        EXPECT_REPORT(driver, (KC_F));
+    }
+    tap_key(key_play);
+
+    // The whole macro still plays, followed by the keys that fit in the queue along with their releases
+    key_c.press();
+    key_d.press();
+    key_e.press();
+    key_f.press();
+    key_g.press();
+    run_one_scan_loop();
+    key_c.release();
+    key_d.release();
+    key_e.release();
+    key_f.release();
+    key_g.release();
+    run_one_scan_loop();
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    WaitForPlayback();
+    VERIFY_AND_CLEAR(driver);
+
+    // The press and release of G are both reported as ignored
+    ASSERT_EQ(ignored_events.size(), 2);
+    EXPECT_TRUE(KEYEQ(ignored_events[0].key, key_g.position));
+    EXPECT_TRUE(ignored_events[0].pressed);
+    EXPECT_TRUE(KEYEQ(ignored_events[1].key, key_g.position));
+    EXPECT_FALSE(ignored_events[1].pressed);
+}
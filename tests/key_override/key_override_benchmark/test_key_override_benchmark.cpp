@@ -0,0 +1,55 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+#define BENCHMARK_KEY_EVENTS 1000000
+
+class KeyOverrideBenchmark : public TestFixture {};
+
+// Not a pass/fail test: reports the average cost of `process_key_override()`
+// per key event with 161 overrides, typing letters with the odd Shift.
+TEST_F(KeyOverrideBenchmark, KeyEventCost) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    std::mt19937                       rng(161);
+    std::uniform_int_distribution<int> keycode(KC_A, KC_Z);
+    std::uniform_int_distribution<int> mods(0, 15);
+
+    struct event {
+        uint16_t keycode;
+        uint8_t  mods;
+    };
+    std::vector<event> events;
+    while (events.size() < BENCHMARK_KEY_EVENTS) {
+        // None of these activate an override, so only finding out costs time
+        events.push_back({(uint16_t)keycode(rng), (uint8_t)(mods(rng) < 14 ? 0 : MOD_BIT(KC_LSFT))});
+    }
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const event &e : events) {
+        set_mods(e.mods);
+        record.event.pressed = true;
+        process_key_override(e.keycode, &record);
+        record.event.pressed = false;
+        process_key_override(e.keycode, &record);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("key override, 161 overrides: %.1f ns/key event\n", (double)elapsed.count() / (2 * events.size()));
+
+    clear_mods();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,141 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+extern "C" {
+extern bool mod_only_override_active;
+}
+
+class KeyOverride : public TestFixture {
+   public:
+    void SetUp() override {
+        mod_only_override_active = false;
+    }
+};
+
+// Test that an override past the 156 others is found
+TEST_F(KeyOverride, OverrideAfterManyOthersActivates) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_esc   = KeymapKey(0, 1, 0, KC_ESC);
+
+    set_keymap({key_shift, key_esc});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The first Shift + Esc override in the list wins
+    EXPECT_REPORT(driver, (KC_HOME));
+    key_esc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_esc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that of two overrides for the same trigger, the first one that matches the mods takes precedence
+TEST_F(KeyOverride, FirstMatchingOverrideTakesPrecedence) {
+    TestDriver driver;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_ctrl  = KeymapKey(0, 1, 0, KC_LCTL);
+    auto       key_1     = KeymapKey(0, 2, 0, KC_1);
+
+    set_keymap({key_shift, key_ctrl, key_1});
+
+    // Allow any number of reports with only modifiers.
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT, KC_LCTL)).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LCTL)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+
+    // Shift + 1 = 2
+    EXPECT_REPORT(driver, (KC_2));
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_1);
+
+    // Shift + Ctrl + 1 = 3
+    EXPECT_REPORT(driver, (KC_3));
+    key_ctrl.press();
+    run_one_scan_loop();
+    tap_key(key_1);
+    key_ctrl.release();
+    key_shift.release();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that an override activates when its mods go down while the last key pressed is its trigger
+TEST_F(KeyOverride, ModifierPressedAfterTriggerActivates) {
+    TestDriver driver;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_esc   = KeymapKey(0, 1, 0, KC_ESC);
+
+    set_keymap({key_shift, key_esc});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_esc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The replacement is registered after the key repeat delay
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_HOME));
+    key_shift.press();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(AnyNumber());
+    key_esc.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that an override without a trigger key activates on its mods alone
+TEST_F(KeyOverride, ModOnlyOverrideActivates) {
+    TestDriver driver;
+    auto       key_rshift = KeymapKey(0, 0, 0, KC_RSFT);
+    auto       key_ralt   = KeymapKey(0, 1, 0, KC_RALT);
+
+    set_keymap({key_rshift, key_ralt});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    key_rshift.press();
+    run_one_scan_loop();
+    EXPECT_FALSE(mod_only_override_active);
+
+    key_ralt.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(mod_only_override_active);
+
+    key_ralt.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(mod_only_override_active);
+
+    key_rshift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+bool mod_only_override_active = false;
+
+static bool mod_only_override_action(bool activated, void *context) {
+    mod_only_override_active = activated;
+    return false;
+}
+
+// Right Shift + Right Alt, with no trigger key
+static const key_override_t mod_only_override = {
+    .trigger_mods      = MOD_BIT(KC_RIGHT_SHIFT) | MOD_BIT(KC_RIGHT_ALT),
+    .layers            = ~0,
+    .suppressed_mods   = 0,
+    .options           = ko_options_default,
+    .negative_mod_mask = 0,
+    .custom_action     = mod_only_override_action,
+    .context           = NULL,
+    .trigger           = KC_NO,
+    .replacement       = KC_NO,
+    .enabled           = NULL,
+};
+
+// clang-format off
+#define FILLER_OVERRIDE(mods, key) &ko_make_basic(mods, key, KC_NO)
+#define FILLER_OVERRIDES(mods) \
+    FILLER_OVERRIDE(mods, KC_A), FILLER_OVERRIDE(mods, KC_B), FILLER_OVERRIDE(mods, KC_C), FILLER_OVERRIDE(mods, KC_D), \
+    FILLER_OVERRIDE(mods, KC_E), FILLER_OVERRIDE(mods, KC_F), FILLER_OVERRIDE(mods, KC_G), FILLER_OVERRIDE(mods, KC_H), \
+    FILLER_OVERRIDE(mods, KC_I), FILLER_OVERRIDE(mods, KC_J), FILLER_OVERRIDE(mods, KC_K), FILLER_OVERRIDE(mods, KC_L), \
+    FILLER_OVERRIDE(mods, KC_M), FILLER_OVERRIDE(mods, KC_N), FILLER_OVERRIDE(mods, KC_O), FILLER_OVERRIDE(mods, KC_P), \
+    FILLER_OVERRIDE(mods, KC_Q), FILLER_OVERRIDE(mods, KC_R), FILLER_OVERRIDE(mods, KC_S), FILLER_OVERRIDE(mods, KC_T), \
+    FILLER_OVERRIDE(mods, KC_U), FILLER_OVERRIDE(mods, KC_V), FILLER_OVERRIDE(mods, KC_W), FILLER_OVERRIDE(mods, KC_X), \
+    FILLER_OVERRIDE(mods, KC_Y), FILLER_OVERRIDE(mods, KC_Z)
+
+// 156 overrides on letters with Ctrl, Alt and GUI ahead of the ones under test, which have to be found past them
+const key_override_t *key_overrides[] = {
+    FILLER_OVERRIDES(MOD_MASK_CTRL),
+    FILLER_OVERRIDES(MOD_MASK_ALT),
+    FILLER_OVERRIDES(MOD_MASK_GUI),
+    FILLER_OVERRIDES(MOD_MASK_CA),
+    FILLER_OVERRIDES(MOD_MASK_CG),
+    FILLER_OVERRIDES(MOD_MASK_AG),
+    // Shift + Esc = Home, the second one never activates as the first takes precedence
+    &ko_make_basic(MOD_MASK_SHIFT, KC_ESC, KC_HOME),
+    &ko_make_basic(MOD_MASK_SHIFT, KC_ESC, KC_END),
+    // Shift + 1 = 2, but Shift + Ctrl + 1 = 3 as that one comes first
+    &ko_make_basic(MOD_MASK_CS, KC_1, KC_3),
+    &ko_make_basic(MOD_MASK_SHIFT, KC_1, KC_2),
+    &mod_only_override,
+};
+// clang-format on
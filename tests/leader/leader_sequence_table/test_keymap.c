@@ -0,0 +1,23 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+uint16_t leader_sequence_matched_count = 0;
+uint16_t leader_sequence_matched_index = UINT16_MAX;
+
+// Deliberately out of order, the matcher sorts them
+const leader_sequence_t leader_sequences[] PROGMEM = {
+    LEADER_SEQUENCE(KC_3, KC_A, KC_B, KC_C),
+    LEADER_SEQUENCE(KC_4, KC_X, KC_Y),
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_NO, KC_D),
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_5, KC_A, KC_B, KC_C, KC_D, KC_E),
+};
+
+bool leader_sequence_matched_user(uint16_t index) {
+    leader_sequence_matched_count++;
+    leader_sequence_matched_index = index;
+    return true;
+}
@@ -0,0 +1,155 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+extern uint16_t leader_sequence_matched_count;
+extern uint16_t leader_sequence_matched_index;
+}
+
+class LeaderSequenceTable : public TestFixture {
+   public:
+    void SetUp() override {
+        leader_sequence_matched_count = 0;
+        leader_sequence_matched_index = UINT16_MAX;
+    }
+};
+
+TEST_F(LeaderSequenceTable, unambiguous_sequence_ends_without_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_x      = KeymapKey(0, 1, 0, KC_X);
+    auto key_y      = KeymapKey(0, 2, 0, KC_Y);
+
+    set_keymap({key_leader, key_x, key_y});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_y);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_matched_count, 1);
+    EXPECT_EQ(leader_sequence_matched_index, 1);
+}
+
+TEST_F(LeaderSequenceTable, prefix_of_longer_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_leader, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_matched_index, 2);
+}
+
+TEST_F(LeaderSequenceTable, middle_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_b      = KeymapKey(0, 2, 0, KC_B);
+
+    set_keymap({key_leader, key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+
+    EXPECT_EQ(leader_sequence_matched_index, 4);
+}
+
+TEST_F(LeaderSequenceTable, longest_sequence_ends_without_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_b      = KeymapKey(0, 2, 0, KC_B);
+    auto key_c      = KeymapKey(0, 3, 0, KC_C);
+    auto key_d      = KeymapKey(0, 4, 0, KC_D);
+    auto key_e      = KeymapKey(0, 5, 0, KC_E);
+
+    set_keymap({key_leader, key_a, key_b, key_c, key_d, key_e});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_keys(key_a, key_b, key_c, key_d);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_e);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_matched_count, 1);
+    EXPECT_EQ(leader_sequence_matched_index, 5);
+}
+
+TEST_F(LeaderSequenceTable, sequence_without_keycode_only_calls_back) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_d      = KeymapKey(0, 1, 0, KC_D);
+
+    set_keymap({key_leader, key_d});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_d);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_matched_count, 1);
+    EXPECT_EQ(leader_sequence_matched_index, 3);
+}
+
+TEST_F(LeaderSequenceTable, dead_end_ends_sequence) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_z      = KeymapKey(0, 2, 0, KC_Z);
+
+    set_keymap({key_leader, key_a, key_z});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_z);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_matched_count, 0);
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_z);
+}
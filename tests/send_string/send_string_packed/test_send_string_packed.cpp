@@ -0,0 +1,171 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+
+namespace {
+
+// Turns the keys newly pressed in each report back into the characters they type, in the order a host
+// processes them: ascending keycodes for NKRO reports, slot order for 6KRO reports.
+class ReportDecoder {
+   public:
+    ReportDecoder() {
+        for (int c = 127; c > 0; c--) {
+            uint8_t keycode = ascii_to_keycode_lut[c];
+            if (keycode != KC_NO) {
+                m_chars[{keycode, shifted(c)}] = c;
+            }
+        }
+    }
+
+    void nkro(const report_nkro_t &report) {
+        m_reports++;
+        for (uint16_t keycode = 0; keycode < NKRO_REPORT_BITS * 8; keycode++) {
+            bool down = report.bits[keycode / 8] & (1 << (keycode % 8));
+            bool was  = m_last_bits[keycode / 8] & (1 << (keycode % 8));
+            if (down && !was) {
+                type(keycode, report.mods);
+            }
+        }
+        memcpy(m_last_bits, report.bits, sizeof(m_last_bits));
+    }
+
+    void keyboard(const report_keyboard_t &report) {
+        m_reports++;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            uint8_t keycode = report.keys[i];
+            if (keycode && !memchr(m_last_keys, keycode, sizeof(m_last_keys))) {
+                type(keycode, report.mods);
+            }
+        }
+        memcpy(m_last_keys, report.keys, sizeof(m_last_keys));
+    }
+
+    const std::string &text() const {
+        return m_text;
+    }
+
+    size_t reports() const {
+        return m_reports;
+    }
+
+    double chars_per_report() const {
+        return m_reports ? double(m_text.size()) / m_reports : 0;
+    }
+
+   private:
+    static bool shifted(uint8_t c) {
+        return (ascii_to_shift_lut[c / 8] >> (c % 8)) & 1;
+    }
+
+    void type(uint8_t keycode, uint8_t mods) {
+        auto it = m_chars.find({keycode, (mods & MOD_BIT(KC_LEFT_SHIFT)) != 0});
+        m_text += it != m_chars.end() ? it->second : '?';
+    }
+
+    std::map<std::pair<uint8_t, bool>, char> m_chars;
+    std::string                              m_text;
+    size_t                                   m_reports                       = 0;
+    uint8_t                                  m_last_bits[NKRO_REPORT_BITS]   = {};
+    uint8_t                                  m_last_keys[KEYBOARD_REPORT_KEYS] = {};
+};
+
+const char *const sample_text = "Hello, World! The quick brown fox jumps over the lazy dog.\n"
+                                "Pack my box with five dozen liquor jugs; 0123456789 (aabbcc) ~/.config\n";
+
+} // namespace
+
+class SendStringPacked : public TestFixture {
+   protected:
+    void capture(TestDriver &driver, ReportDecoder &decoder) {
+        EXPECT_CALL(driver, send_nkro_mock(_)).WillRepeatedly(Invoke([&](report_nkro_t &report) { decoder.nkro(report); }));
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) { decoder.keyboard(report); }));
+    }
+};
+
+TEST_F(SendStringPacked, PacksAscendingKeysIntoOneReport) {
+    TestDriver driver;
+    InSequence s;
+
+    keymap_config.nkro = true;
+    // one report pressing A, B and C, one releasing them
+    EXPECT_CALL(driver, send_nkro_mock(KeyboardReport(KC_A, KC_B, KC_C)));
+    EXPECT_CALL(driver, send_nkro_mock(KeyboardReport()));
+
+    send_string_packed("abc");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, RepeatedKeyIsReleasedFirst) {
+    TestDriver    driver;
+    ReportDecoder decoder;
+
+    keymap_config.nkro = true;
+    capture(driver, decoder);
+
+    send_string_packed("aab");
+
+    EXPECT_EQ(decoder.text(), "aab");
+    EXPECT_EQ(decoder.reports(), 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, DecodesBackToText) {
+    TestDriver    driver;
+    ReportDecoder packed;
+    ReportDecoder tapped;
+
+    keymap_config.nkro = true;
+    capture(driver, packed);
+    send_string_packed(sample_text);
+    VERIFY_AND_CLEAR(driver);
+
+    capture(driver, tapped);
+    send_string(sample_text);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(packed.text(), sample_text);
+    EXPECT_EQ(tapped.text(), sample_text);
+    RecordProperty("packed_chars_per_report", std::to_string(packed.chars_per_report()));
+    RecordProperty("tapped_chars_per_report", std::to_string(tapped.chars_per_report()));
+    EXPECT_GT(packed.chars_per_report(), 2 * tapped.chars_per_report());
+}
+
+TEST_F(SendStringPacked, FallsBackTo6kro) {
+    TestDriver    driver;
+    ReportDecoder decoder;
+
+    keymap_config.nkro = false;
+    capture(driver, decoder);
+
+    send_string_packed(sample_text);
+
+    EXPECT_EQ(decoder.text(), sample_text);
+    // a single new key per report, the previous one is released in the same report
+    EXPECT_LE(decoder.chars_per_report(), 1.0);
+    EXPECT_GT(decoder.chars_per_report(), 0.5);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, EscapesKeepTheirPlace) {
+    TestDriver    driver;
+    ReportDecoder decoder;
+
+    keymap_config.nkro = true;
+    capture(driver, decoder);
+
+    send_string_packed("ab" SS_TAP(X_ENTER) "cd" SS_LSFT("e") "f");
+
+    EXPECT_EQ(decoder.text(), "ab\ncdEf");
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,161 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {};
+
+TEST_F(SendStringAsync, SendsOneReportPerScanLoop) {
+    TestDriver driver;
+
+    // Nothing is sent until the main loop runs
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("ab"));
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SharesShiftBetweenCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(send_string_async("AB"));
+    EXPECT_TRUE(send_string_async("c"));
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, RejectsStringLongerThanQueue) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_FALSE(send_string_async(std::string(SEND_STRING_ASYNC_QUEUE_SIZE, 'a').c_str()));
+    EXPECT_FALSE(send_string_async_busy());
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    // A string that fits is still accepted once the rejected one left nothing behind
+    EXPECT_TRUE(send_string_async(std::string(SEND_STRING_ASYNC_QUEUE_SIZE - 2, 'a').c_str()));
+    EXPECT_FALSE(send_string_async("a"));
+
+    EXPECT_REPORT(driver, (KC_A)).Times(SEND_STRING_ASYNC_QUEUE_SIZE - 2);
+    EXPECT_EMPTY_REPORT(driver).Times(SEND_STRING_ASYNC_QUEUE_SIZE - 2);
+    idle_for(2 * SEND_STRING_ASYNC_QUEUE_SIZE);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, HandlesTapAndDelayEscapes) {
+    TestDriver driver;
+
+    EXPECT_TRUE(send_string_async(SS_TAP(X_ENTER) SS_DELAY(10) "a"));
+
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+
+    // the delay holds the next key back without blocking the loop
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, MatrixKeepsScanningWhileDraining) {
+    TestDriver driver;
+    KeymapKey  key_b = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key_b});
+
+    EXPECT_TRUE(send_string_async("a"));
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SyncSendStringWaitsForQueue) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(send_string_async("a"));
+    send_string("b");
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, QueuesUnicodeString) {
+    TestDriver driver;
+    InSequence s;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_UNICODE(driver, 0x00E9);
+    EXPECT_UNICODE(driver, 0x1F9D9);
+
+    EXPECT_TRUE(send_string_async("a"));
+    send_unicode_string_async("é🧙");
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
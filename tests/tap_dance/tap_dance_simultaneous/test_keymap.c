@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    ACTION_TAP_DANCE_DOUBLE(KC_A, KC_1),
+    ACTION_TAP_DANCE_DOUBLE(KC_B, KC_2),
+    ACTION_TAP_DANCE_DOUBLE(KC_C, KC_3),
+    ACTION_TAP_DANCE_DOUBLE(KC_D, KC_4),
+    ACTION_TAP_DANCE_DOUBLE(KC_E, KC_5),
+    ACTION_TAP_DANCE_DOUBLE(KC_F, KC_6),
+};
+// clang-format on
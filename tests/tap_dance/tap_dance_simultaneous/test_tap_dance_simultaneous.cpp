@@ -0,0 +1,183 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class TapDanceSimultaneous : public TestFixture {};
+
+TEST_F(TapDanceSimultaneous, RollHoldsAsManyDancesAsThePool) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey{0, 0, 0, TD(0)};
+    auto       key_b = KeymapKey{0, 1, 0, TD(1)};
+    auto       key_c = KeymapKey{0, 2, 0, TD(2)};
+    auto       key_d = KeymapKey{0, 3, 0, TD(3)};
+    auto       key_e = KeymapKey{0, 4, 0, TD(4)};
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e});
+
+    /* Each press finishes the dance before it, which is still held */
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A));
+    key_b.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_c.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The pool is used up, a fifth dance won't happen */
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    key_e.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    key_d.release();
+    run_one_scan_loop();
+    key_e.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceSimultaneous, SlotsAreReusedInAnyOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey{0, 0, 0, TD(0)};
+    auto       key_b = KeymapKey{0, 1, 0, TD(1)};
+    auto       key_c = KeymapKey{0, 2, 0, TD(2)};
+    auto       key_d = KeymapKey{0, 3, 0, TD(3)};
+    auto       key_e = KeymapKey{0, 4, 0, TD(4)};
+    auto       key_f = KeymapKey{0, 5, 0, TD(5)};
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Releasing the first dance frees its slot for another one */
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E));
+    key_a.release();
+    run_one_scan_loop();
+    key_d.press();
+    run_one_scan_loop();
+    key_e.press();
+    run_one_scan_loop();
+    key_f.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    key_d.release();
+    run_one_scan_loop();
+    key_e.release();
+    run_one_scan_loop();
+    key_f.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Every slot is free again */
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_REPORT(driver, (KC_F, KC_A));
+    EXPECT_REPORT(driver, (KC_F, KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_F, KC_A, KC_B, KC_C));
+    key_f.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_c.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_f.release();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceSimultaneous, DanceFinishesAfterTappingTerm) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey{0, 0, 0, TD(0)};
+
+    set_keymap({key_a});
+
+    /* Every tap restarts the tapping term */
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* A single tap is sent once the tapping term has passed */
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -31,23 +31,31 @@ namespace {
 
 std::vector<uint8_t> get_keys(const report_keyboard_t& report) {
     std::vector<uint8_t> result;
-#if defined(NKRO_ENABLE)
-#    error NKRO support not implemented yet
-#else
     for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
         if (report.keys[i]) {
             result.emplace_back(report.keys[i]);
         }
     }
-#endif
     std::sort(result.begin(), result.end());
     return result;
 }
 
-std::vector<uint8_t> get_mods(const report_keyboard_t& report) {
+#ifdef NKRO_ENABLE
+std::vector<uint8_t> get_keys(const report_nkro_t& report) {
+    std::vector<uint8_t> result;
+    for (size_t i = 0; i < NKRO_REPORT_BITS * 8; i++) {
+        if (report.bits[i >> 3] & (1 << (i & 7))) {
+            result.emplace_back(i);
+        }
+    }
+    return result;
+}
+#endif
+
+std::vector<uint8_t> get_mods(uint8_t mods) {
     std::vector<uint8_t> result;
     for (size_t i = 0; i < 8; i++) {
-        if (report.mods & (1 << i)) {
+        if (mods & (1 << i)) {
             uint8_t code = KC_LEFT_CTRL + i;
             result.emplace_back(code);
         }
@@ -56,17 +64,8 @@ std::vector<uint8_t> get_mods(const report_keyboard_t& report) {
     return result;
 }
 
-} // namespace
-
-bool operator==(const report_keyboard_t& lhs, const report_keyboard_t& rhs) {
-    auto lhskeys = get_keys(lhs);
-    auto rhskeys = get_keys(rhs);
-    return lhs.mods == rhs.mods && lhskeys == rhskeys;
-}
-
-std::ostream& operator<<(std::ostream& os, const report_keyboard_t& report) {
-    auto keys = get_keys(report);
-    auto mods = get_mods(report);
+std::ostream& print_report(std::ostream& os, const std::vector<uint8_t>& keys, uint8_t mods_bits) {
+    auto mods = get_mods(mods_bits);
 
     os << std::setw(10) << std::left << "report: ";
 
@@ -96,25 +95,57 @@ std::ostream& operator<<(std::ostream& os, const report_keyboard_t& report) {
     return os << "]" << std::endl;
 }
 
-KeyboardReportMatcher::KeyboardReportMatcher(const std::vector<uint8_t>& keys) {
-    memset(&m_report, 0, sizeof(report_keyboard_t));
+} // namespace
+
+bool operator==(const report_keyboard_t& lhs, const report_keyboard_t& rhs) {
+    auto lhskeys = get_keys(lhs);
+    auto rhskeys = get_keys(rhs);
+    return lhs.mods == rhs.mods && lhskeys == rhskeys;
+}
+
+std::ostream& operator<<(std::ostream& os, const report_keyboard_t& report) {
+    return print_report(os, get_keys(report), report.mods);
+}
+
+#ifdef NKRO_ENABLE
+bool operator==(const report_nkro_t& lhs, const report_nkro_t& rhs) {
+    auto lhskeys = get_keys(lhs);
+    auto rhskeys = get_keys(rhs);
+    return lhs.mods == rhs.mods && lhskeys == rhskeys;
+}
+
+std::ostream& operator<<(std::ostream& os, const report_nkro_t& report) {
+    return print_report(os, get_keys(report), report.mods);
+}
+#endif
+
+KeyboardReportMatcher::KeyboardReportMatcher(const std::vector<uint8_t>& keys) : m_mods(0) {
     for (auto k : keys) {
         if (IS_MODIFIER_KEYCODE(k)) {
-            m_report.mods |= MOD_BIT(k);
-        } else {
-            add_key_byte(&m_report, k);
+            m_mods |= MOD_BIT(k);
+        } else if (k != KC_NO && std::find(m_keys.begin(), m_keys.end(), k) == m_keys.end()) {
+            m_keys.emplace_back(k);
         }
     }
+    std::sort(m_keys.begin(), m_keys.end());
 }
 
 bool KeyboardReportMatcher::MatchAndExplain(report_keyboard_t& report, MatchResultListener* listener) const {
-    return m_report == report;
+    return report.mods == m_mods && get_keys(report) == m_keys;
+}
+
+#ifdef NKRO_ENABLE
+bool KeyboardReportMatcher::MatchAndExplain(report_nkro_t& report, MatchResultListener* listener) const {
+    return report.mods == m_mods && get_keys(report) == m_keys;
 }
+#endif
 
 void KeyboardReportMatcher::DescribeTo(::std::ostream* os) const {
-    *os << "is equal to " << m_report;
+    *os << "is equal to ";
+    print_report(*os, m_keys, m_mods);
 }
 
 void KeyboardReportMatcher::DescribeNegationTo(::std::ostream* os) const {
-    *os << "is not equal to " << m_report;
+    *os << "is not equal to ";
+    print_report(*os, m_keys, m_mods);
 }
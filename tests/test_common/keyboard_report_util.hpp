@@ -21,19 +21,28 @@
 
 bool operator==(const report_keyboard_t& lhs, const report_keyboard_t& rhs);
 std::ostream& operator<<(std::ostream& stream, const report_keyboard_t& value);
+#ifdef NKRO_ENABLE
+bool operator==(const report_nkro_t& lhs, const report_nkro_t& rhs);
+std::ostream& operator<<(std::ostream& stream, const report_nkro_t& value);
+#endif
 
-class KeyboardReportMatcher : public testing::MatcherInterface<report_keyboard_t&> {
+// Matches both 6KRO reports, and NKRO reports when NKRO is enabled
+class KeyboardReportMatcher {
  public:
     KeyboardReportMatcher(const std::vector<uint8_t>& keys);
-    virtual bool MatchAndExplain(report_keyboard_t& report, testing::MatchResultListener* listener) const override;
-    virtual void DescribeTo(::std::ostream* os) const override;
-    virtual void DescribeNegationTo(::std::ostream* os) const override;
+    bool MatchAndExplain(report_keyboard_t& report, testing::MatchResultListener* listener) const;
+#ifdef NKRO_ENABLE
+    bool MatchAndExplain(report_nkro_t& report, testing::MatchResultListener* listener) const;
+#endif
+    void DescribeTo(::std::ostream* os) const;
+    void DescribeNegationTo(::std::ostream* os) const;
 private:
-    report_keyboard_t m_report;
+    std::vector<uint8_t> m_keys;
+    uint8_t              m_mods;
 };
 
 
 template<typename... Ts>
-inline testing::Matcher<report_keyboard_t&> KeyboardReport(Ts... keys) {
-    return testing::MakeMatcher(new KeyboardReportMatcher(std::vector<uint8_t>({keys...})));
+inline testing::PolymorphicMatcher<KeyboardReportMatcher> KeyboardReport(Ts... keys) {
+    return testing::MakePolymorphicMatcher(KeyboardReportMatcher(std::vector<uint8_t>({keys...})));
 }